@@ -3,7 +3,7 @@
  * HMS StatusLED Driver - ESP32 Usage Example
  * 
  * This example shows how to use the HMS StatusLED Driver with ESP32 (Arduino Framework)
- * Uses the RMT peripheral for precise WS2812B timing
+ * Uses the RMT peripheral (TX channel + bytes encoder on ESP-IDF 5) for precise WS2812B timing
  ====================================================================================================
  */
 
@@ -17,9 +17,10 @@ void setup() {
     Serial.begin(115200);
     Serial.println("HMS StatusLED Driver - ESP32 Example");
     
-    // Initialize the driver with GPIO pin and RMT channel
-    // Parameters: pin, rmt_channel (optional, defaults to RMT_CHANNEL_0)
-    if (led.begin(5, RMT_CHANNEL_0) != HMS_STATUSLED_OK) {
+    // Initialize the driver with the GPIO pin
+    // ESP-IDF 5+ allocates the RMT channel itself, with HMS_STATUSLED_RMT_LEGACY_DRIVER
+    // an rmt_channel_t can be passed as second parameter (defaults to RMT_CHANNEL_0)
+    if (led.begin(5) != HMS_STATUSLED_OK) {
         Serial.println("Failed to initialize LED driver!");
         return;
     }
@@ -49,10 +50,7 @@ void rainbowCycle() {
     
     for (int cycle = 0; cycle < 5; cycle++) {
         for (int hue = 0; hue < 256; hue += 2) {
-            for (int i = 0; i < 60; i++) {
-                uint32_t color = wheel((hue + i * 4) & 255);
-                led.setPixelColor(color, i);
-            }
+            led.fillRainbow(0, 60, hue, 4);     // Integer HSV in the driver, 4 hue steps per LED
             led.show();
             delay(20);
         }
@@ -62,7 +60,7 @@ void rainbowCycle() {
 void colorWheel() {
     Serial.println("Running color wheel...");
     
-    // Using RGB888 colors (auto-detected)
+    // Using RGB888 colors
     uint32_t colors[] = {
         HMS_STATUSLED_RGB888_RED,
         HMS_STATUSLED_RGB888_ORANGE,
@@ -142,20 +140,6 @@ void breathingEffect() {
     }
 }
 
-// Color wheel function to generate rainbow colors
-uint32_t wheel(uint8_t wheelPos) {
-    wheelPos = 255 - wheelPos;
-    if (wheelPos < 85) {
-        return HMS_STATUSLED_RGB_TO_888(255 - wheelPos * 3, 0, wheelPos * 3);
-    }
-    if (wheelPos < 170) {
-        wheelPos -= 85;
-        return HMS_STATUSLED_RGB_TO_888(0, wheelPos * 3, 255 - wheelPos * 3);
-    }
-    wheelPos -= 170;
-    return HMS_STATUSLED_RGB_TO_888(wheelPos * 3, 255 - wheelPos * 3, 0);
-}
-
 // Simple patterns for testing
 void testPattern() {
     Serial.println("Running test pattern...");
@@ -166,7 +150,7 @@ void testPattern() {
     led.setPixelColor(HMS_STATUSLED_RGB888_BLUE, 2);     // Pixel 2: Blue
     led.setPixelColor(0xFF00FF, 3);                      // Pixel 3: Magenta (RGB888)
     
-    // Using RGB565 colors (auto-detected)
+    // Using RGB565 colors (tagged constants)
     led.setPixelColor(HMS_STATUSLED_RGB565_YELLOW, 4);   // Pixel 4: Yellow
     led.setPixelColor(HMS_STATUSLED_RGB565_CYAN, 5);     // Pixel 5: Cyan
     
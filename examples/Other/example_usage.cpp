@@ -36,13 +36,13 @@ void statusLED_example() {
     
     // Set individual pixels using different color formats
     
-    // Using RGB888 colors (auto-detected)
+    // Using RGB888 colors
     led.setPixelColor(HMS_STATUSLED_RGB888_RED, 0);      // Pixel 0: Red
     led.setPixelColor(HMS_STATUSLED_RGB888_GREEN, 1);    // Pixel 1: Green  
     led.setPixelColor(HMS_STATUSLED_RGB888_BLUE, 2);     // Pixel 2: Blue
     led.setPixelColor(0xFF00FF, 3);                      // Pixel 3: Magenta
     
-    // Using RGB565 colors (auto-detected)
+    // Using RGB565 colors (tagged constants)
     led.setPixelColor(HMS_STATUSLED_RGB565_YELLOW, 4);   // Pixel 4: Yellow
     led.setPixelColor(HMS_STATUSLED_RGB565_CYAN, 5);     // Pixel 5: Cyan
     
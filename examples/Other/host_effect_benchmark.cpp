@@ -0,0 +1,67 @@
+/*
+ ====================================================================================================
+ * HMS StatusLED Driver - Effect Kernel Benchmark (Linux host)
+ *
+ * Cost per pixel per frame of every built-in effect: the kernel alone into a packed RGB888 buffer,
+ * the kernel writing the pixels through renderEffect() (gamma, color order, brightness), and a full
+ * frame including the encode of the host backend. Time advances by 16 ms per frame, so every kernel
+ * walks through all of its phases.
+ *
+ * Build: g++ -std=c++17 -O2 -DHMS_STATUSLED_HOST -Iinclude src/HMS_StatusLED_DRIVER.cpp \
+ *            examples/Other/host_effect_benchmark.cpp -o effect_benchmark
+ ====================================================================================================
+ */
+
+#include "HMS_StatusLED_DRIVER.h"
+
+#include <chrono>
+
+#define PIXELS          300
+#define FRAMES          20000
+
+static const struct {
+    const char                  *name;
+    HMS_StatusLED_Effect        effect;
+} effects[] = {
+    { "breathe",    { HMS_STATUSLED_EFFECT_BREATHE,  HMS_STATUSLED_RGB888_BLUE,   0x000000, 2000, 0   } },
+    { "blink",      { HMS_STATUSLED_EFFECT_BLINK,    HMS_STATUSLED_RGB888_RED,    0x000000, 1000, 0   } },
+    { "chase",      { HMS_STATUSLED_EFFECT_CHASE,    HMS_STATUSLED_RGB888_ORANGE, 0x000000, 3000, 3   } },
+    { "scanner",    { HMS_STATUSLED_EFFECT_SCANNER,  HMS_STATUSLED_RGB888_RED,    0x000000, 2000, 6   } },
+    { "rainbow",    { HMS_STATUSLED_EFFECT_RAINBOW,  0x000000,                    0x000000, 5000, 0   } },
+    { "sparkle",    { HMS_STATUSLED_EFFECT_SPARKLE,  0xFFFFFF,                    0x000010,  400, 20  } },
+    { "fire",       { HMS_STATUSLED_EFFECT_FIRE,     0x000000,                    0x000000,   80, 180 } },
+    { "comet",      { HMS_STATUSLED_EFFECT_COMET,    HMS_STATUSLED_RGB888_GREEN,  0x000000, 1500, 12  } },
+    { "progress",   { HMS_STATUSLED_EFFECT_PROGRESS, HMS_STATUSLED_RGB888_GREEN,  0x100000,    0, 170 } },
+};
+
+static volatile uint32_t sink;                                                                              // Keeps the kernel-only loop from being optimised away
+
+template <typename Body>
+static double nsPerPixel(Body body) {
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t frame = 0; frame < FRAMES; frame++) body(frame * 16);
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    return ns / FRAMES / PIXELS;
+}
+
+int main() {
+    HMS_StatusLED led(PIXELS, HMS_STATUSLED_TYPE_WS281XX, HMS_STATUSLED_ORDER_GRB);
+    led.begin(80);
+    uint32_t frame[PIXELS];
+
+    printf("%d pixels, %d frames, ns per pixel per frame\n\n", PIXELS, FRAMES);
+    printf("%-10s %10s %14s %14s\n", "effect", "kernel", "renderEffect", "+ show()");
+
+    for (const auto &entry : effects) {
+        double kernel = nsPerPixel([&](uint32_t nowMs) {
+            HMS_StatusLED::renderEffectFrame(entry.effect, nowMs, frame, PIXELS);
+            sink = frame[nowMs % PIXELS];
+        });
+        double render = nsPerPixel([&](uint32_t nowMs) { led.renderEffect(entry.effect, nowMs); });
+        double show   = nsPerPixel([&](uint32_t nowMs) { led.renderEffect(entry.effect, nowMs); led.show(); });
+
+        printf("%-10s %10.2f %14.2f %14.2f\n", entry.name, kernel, render, show);
+    }
+
+    return 0;
+}
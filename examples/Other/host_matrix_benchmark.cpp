@@ -0,0 +1,68 @@
+/*
+ ====================================================================================================
+ * HMS StatusLED Driver - Matrix Layout Benchmark (Linux host)
+ *
+ * Cost per pixel of drawing a full RGB bitmap onto 2x2 tiled 16x16 serpentine panels: one
+ * setPixelXY() per pixel against blit(), which writes whole strip runs from the bitmap, for every
+ * rotation. A column-wired layout is included, its rows have no strip runs to stream.
+ *
+ * Build: g++ -std=c++17 -O2 -DHMS_STATUSLED_HOST -Iinclude src/HMS_StatusLED_DRIVER.cpp src/HMS_StatusLED_Matrix.cpp \
+ *            examples/Other/host_matrix_benchmark.cpp -o matrix_benchmark
+ ====================================================================================================
+ */
+
+#include "HMS_StatusLED_Matrix.h"
+
+#include <chrono>
+
+#define PANEL           16
+#define TILES           2
+#define PIXELS          (PANEL * PANEL * TILES * TILES)
+#define FRAMES          5000
+
+template <typename Body>
+static double nsPerPixel(Body body) {
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t frame = 0; frame < FRAMES; frame++) body(frame);
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    return ns / FRAMES / PIXELS;
+}
+
+static void run(const char *name, uint8_t flags, HMS_StatusLED_MatrixRotation rotation) {
+    HMS_StatusLED led(PIXELS, HMS_STATUSLED_TYPE_WS281XX, HMS_STATUSLED_ORDER_GRB);
+    led.begin(80);
+    HMS_StatusLED_Matrix matrix(led, PANEL, PANEL, flags, TILES, TILES, rotation);
+
+    uint16_t width  = matrix.getWidth();
+    uint16_t height = matrix.getHeight();
+    std::vector<uint8_t> bitmap((uint32_t)width * height * 3);
+    for (uint32_t i = 0; i < bitmap.size(); i++) bitmap[i] = (uint8_t)(i * 7);
+
+    double perPixel = nsPerPixel([&](uint32_t frame) {
+        const uint8_t *rgb = bitmap.data();
+        for (uint16_t y = 0; y < height; y++) {
+            for (uint16_t x = 0; x < width; x++, rgb += 3) {
+                matrix.setPixelXY(HMS_STATUSLED_RGB_TO_888(rgb[0], rgb[1], (uint8_t)(rgb[2] + frame)), x, y);
+            }
+        }
+    });
+    double blit = nsPerPixel([&](uint32_t frame) {
+        bitmap[0] = (uint8_t)frame;
+        matrix.blit(bitmap.data(), 0, 0, width, height);
+    });
+
+    printf("%-24s %12.2f %10.2f\n", name, perPixel, blit);
+}
+
+int main() {
+    printf("%dx%d pixels, %d frames, ns per pixel\n\n", PANEL * TILES, PANEL * TILES, FRAMES);
+    printf("%-24s %12s %10s\n", "layout", "setPixelXY", "blit");
+
+    run("serpentine",            HMS_STATUSLED_MATRIX_SERPENTINE, HMS_STATUSLED_MATRIX_ROTATE_0);
+    run("serpentine, 90",        HMS_STATUSLED_MATRIX_SERPENTINE, HMS_STATUSLED_MATRIX_ROTATE_90);
+    run("serpentine, 180",       HMS_STATUSLED_MATRIX_SERPENTINE, HMS_STATUSLED_MATRIX_ROTATE_180);
+    run("serpentine, 270",       HMS_STATUSLED_MATRIX_SERPENTINE, HMS_STATUSLED_MATRIX_ROTATE_270);
+    run("columns",               HMS_STATUSLED_MATRIX_COLUMNS | HMS_STATUSLED_MATRIX_SERPENTINE, HMS_STATUSLED_MATRIX_ROTATE_0);
+
+    return 0;
+}
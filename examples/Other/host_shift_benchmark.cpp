@@ -0,0 +1,80 @@
+/*
+ ====================================================================================================
+ * HMS StatusLED Driver - Shift / Rotate Benchmark (Linux host)
+ *
+ * Moving a pattern by one pixel per frame, three ways: rewriting the pixels through setPixelColor()
+ * like chaserEffect() of the ESP32-C3 example (clear + one pixel, and a full marquee pattern), moving
+ * the stored pixels with rotate(), and moving nothing with setRingOffset(). Each is timed with and
+ * without the show() that follows, on the host backend.
+ *
+ * Build: g++ -std=c++17 -O2 -DHMS_STATUSLED_HOST -Iinclude src/HMS_StatusLED_DRIVER.cpp \
+ *            examples/Other/host_shift_benchmark.cpp -o shift_benchmark
+ ====================================================================================================
+ */
+
+#include "HMS_StatusLED_DRIVER.h"
+
+#include <chrono>
+
+#define PIXELS          300
+#define FRAMES          20000
+
+static uint32_t pattern[PIXELS];
+
+template <typename Body>
+static double usPerFrame(Body body) {
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t frame = 0; frame < FRAMES; frame++) body(frame);
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / FRAMES;
+}
+
+static void run(const char *name, void (*setup)(HMS_StatusLED&), void (*step)(HMS_StatusLED&, uint32_t)) {
+    HMS_StatusLED led(PIXELS, HMS_STATUSLED_TYPE_WS281XX, HMS_STATUSLED_ORDER_GRB);
+    led.begin(80);
+
+    setup(led);
+    double move = usPerFrame([&](uint32_t frame) { step(led, frame); });
+    setup(led);
+    double show = usPerFrame([&](uint32_t frame) { step(led, frame); led.show(); });
+
+    printf("%-30s %10.2f %12.2f\n", name, move, show);
+}
+
+static void noSetup(HMS_StatusLED &led) {
+    led.clear();
+    led.setRingOffset(0);
+}
+
+static void patternSetup(HMS_StatusLED &led) {
+    noSetup(led);
+    led.setPixels888(pattern, PIXELS);
+}
+
+static void chaserSetup(HMS_StatusLED &led) {
+    noSetup(led);
+    led.setPixelColor(HMS_STATUSLED_RGB_TO_888(255, 100, 0), 0);
+}
+
+int main() {
+    for (uint16_t i = 0; i < PIXELS; i++) pattern[i] = HMS_StatusLED::colorHSV(i * 256 / PIXELS, 255, 255);
+
+    printf("%d pixels, %d frames, us per frame\n\n", PIXELS, FRAMES);
+    printf("%-30s %10s %12s\n", "method", "move", "+ show()");
+
+    run("chaser: clear + setPixelColor", noSetup, [](HMS_StatusLED &led, uint32_t frame) {
+        led.clear();                                                                        // chaserEffect() in the ESP32-C3 example
+        led.setPixelColor(HMS_STATUSLED_RGB_TO_888(255, 100, 0), frame % PIXELS);
+    });
+    run("chaser: rotate(1)",             chaserSetup, [](HMS_StatusLED &led, uint32_t) { led.rotate(1); });
+    run("chaser: setRingOffset()",       chaserSetup, [](HMS_StatusLED &led, uint32_t frame) { led.setRingOffset(PIXELS - frame % PIXELS); });
+
+    run("marquee: setPixelColor x all",  noSetup, [](HMS_StatusLED &led, uint32_t frame) {
+        for (uint16_t i = 0; i < PIXELS; i++) led.setPixelColor(pattern[(i + frame) % PIXELS], i);
+    });
+    run("marquee: rotate(-1)",           patternSetup, [](HMS_StatusLED &led, uint32_t) { led.rotate(-1); });
+    run("marquee: shift(1)",             patternSetup, [](HMS_StatusLED &led, uint32_t) { led.shift(1); });
+    run("marquee: mirror()",             patternSetup, [](HMS_StatusLED &led, uint32_t) { led.mirror(); });
+    run("marquee: setRingOffset()",      patternSetup, [](HMS_StatusLED &led, uint32_t frame) { led.setRingOffset(frame % PIXELS); });
+
+    return 0;
+}
@@ -0,0 +1,157 @@
+/*
+ ====================================================================================================
+ * HMS StatusLED Driver - Stream Receiver Benchmark (Linux host)
+ *
+ * Feeds DDP, E1.31 and Art-Net frames for a 510 pixel strip (3 universes) into the stream receiver,
+ * first straight from memory (parse + pixel plane + encode cost only), then over UDP loopback.
+ * Uses the host backend, so every completed frame is encoded and captured like on the target.
+ *
+ * Build: g++ -std=c++17 -O2 -DHMS_STATUSLED_HOST -Iinclude src/HMS_StatusLED_DRIVER.cpp src/HMS_StatusLED_Stream.cpp \
+ *            examples/Other/host_stream_benchmark.cpp -o stream_benchmark -lpthread
+ ====================================================================================================
+ */
+
+#include "HMS_StatusLED_Stream.h"
+
+#include <chrono>
+#include <thread>
+#include <string.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+
+#define PIXELS          510
+#define UNIVERSES       3
+#define FRAMES          20000
+
+typedef std::vector<std::vector<uint8_t>> PacketList;
+
+static void buildE131(PacketList &packets, uint8_t sequence) {
+    for (uint16_t universe = 1; universe <= UNIVERSES; universe++) {
+        std::vector<uint8_t> packet(126 + 510, 0);
+        const uint8_t root[] = {0x00, 0x10, 0x00, 0x00, 'A', 'S', 'C', '-', 'E', '1', '.', '1', '7', 0, 0, 0, 0x72, 0x6e, 0x00, 0x00, 0x00, 0x04};
+        memcpy(packet.data(), root, sizeof(root));
+        packet[40 + 3] = 0x02;                                                  // Framing vector: data
+        packet[108]    = 100;                                                   // Priority
+        packet[111]    = sequence;
+        packet[113]    = universe >> 8;     packet[114] = universe & 0xFF;
+        packet[117]    = 0x02;              packet[118] = 0xA1;
+        packet[122]    = 0x01;                                                  // Address increment
+        packet[123]    = (511 >> 8);        packet[124] = 511 & 0xFF;           // Start code + 510 channels
+        for (int i = 0; i < 510; i++) packet[126 + i] = (uint8_t)(i + sequence);
+        packets.push_back(packet);
+    }
+}
+
+static void buildArtNet(PacketList &packets, uint8_t sequence) {
+    for (uint16_t universe = 0; universe < UNIVERSES; universe++) {
+        std::vector<uint8_t> packet(18 + 510, 0);
+        memcpy(packet.data(), "Art-Net", 8);
+        packet[9]  = 0x50;                                                      // OpDmx, little endian
+        packet[11] = 14;                                                        // Protocol version
+        packet[12] = sequence;
+        packet[14] = universe;
+        packet[16] = 510 >> 8;              packet[17] = 510 & 0xFF;
+        for (int i = 0; i < 510; i++) packet[18 + i] = (uint8_t)(i + sequence);
+        packets.push_back(packet);
+    }
+}
+
+static void buildDDP(PacketList &packets, uint8_t sequence) {
+    for (uint32_t offset = 0; offset < PIXELS * 3; offset += 1440) {             // 480 pixels per packet
+        uint32_t length = (PIXELS * 3 - offset) < 1440 ? (PIXELS * 3 - offset) : 1440;
+        std::vector<uint8_t> packet(10 + length, 0);
+        packet[0] = 0x40 | ((offset + length == PIXELS * 3) ? 0x01 : 0x00);    // Push on the last packet
+        packet[1] = sequence & 0x0F;
+        packet[2] = 0x0B;                                                       // RGB, 8 bit
+        packet[3] = 0x01;
+        packet[4] = offset >> 24;   packet[5] = offset >> 16;   packet[6] = offset >> 8;    packet[7] = offset;
+        packet[8] = length >> 8;    packet[9] = length;
+        for (uint32_t i = 0; i < length; i++) packet[10 + i] = (uint8_t)(i + sequence);
+        packets.push_back(packet);
+    }
+}
+
+static void report(const char *name, HMS_StatusLED_StreamReceiver &receiver, std::chrono::steady_clock::duration elapsed) {
+    double seconds = std::chrono::duration<double>(elapsed).count();
+    printf("%-22s %9.0f packets/s %12.0f pixels/s %8.0f frames/s  (dropped %lu)\n", name,
+           receiver.getPacketCount() / seconds, (double)receiver.getFrameCount() * PIXELS / seconds,
+           receiver.getFrameCount() / seconds, (unsigned long)receiver.getDroppedPackets());
+}
+
+static void benchmarkMemory(const char *name, void (*build)(PacketList&, uint8_t), uint16_t startUniverse) {
+    HMS_StatusLED led(PIXELS, HMS_STATUSLED_TYPE_WS281XX, HMS_STATUSLED_ORDER_GRB);
+    led.begin(80);
+    HMS_StatusLED_StreamReceiver receiver(led, startUniverse);
+
+    PacketList frames[255];                                                     // Sequence numbers 1..255, Art-Net reserves 0
+    for (int sequence = 0; sequence < 255; sequence++) build(frames[sequence], sequence + 1);
+
+    auto start = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < FRAMES; frame++) {
+        for (const std::vector<uint8_t> &packet : frames[frame % 255]) receiver.handlePacket(packet.data(), packet.size());
+    }
+    report(name, receiver, std::chrono::steady_clock::now() - start);
+}
+
+static void benchmarkLoopback(const char *name, void (*build)(PacketList&, uint8_t), uint16_t startUniverse, uint16_t port) {
+    HMS_StatusLED led(PIXELS, HMS_STATUSLED_TYPE_WS281XX, HMS_STATUSLED_ORDER_GRB);
+    led.begin(80);
+    HMS_StatusLED_StreamReceiver receiver(led, startUniverse);
+
+    sockaddr_in address = {};
+    address.sin_family      = AF_INET;
+    address.sin_port        = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    int rx = socket(AF_INET, SOCK_DGRAM, 0);
+    int bufferSize = 4 * 1024 * 1024;
+    setsockopt(rx, SOL_SOCKET, SO_RCVBUF, &bufferSize, sizeof(bufferSize));
+    timeval timeout = {0, 200000};
+    setsockopt(rx, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    if (bind(rx, (sockaddr*)&address, sizeof(address)) != 0) {
+        printf("%-22s cannot bind port %u\n", name, port);
+        close(rx);
+        return;
+    }
+
+    PacketList frames[255];                                                     // Sequence numbers 1..255, Art-Net reserves 0
+    for (int sequence = 0; sequence < 255; sequence++) build(frames[sequence], sequence + 1);
+
+    std::thread sender([&]() {                                                  // Paced in bursts so loopback does not drop
+        int tx = socket(AF_INET, SOCK_DGRAM, 0);
+        for (int frame = 0; frame < FRAMES; frame++) {
+            for (const std::vector<uint8_t> &packet : frames[frame % 255]) {
+                sendto(tx, packet.data(), packet.size(), 0, (sockaddr*)&address, sizeof(address));
+            }
+            if ((frame & 63) == 63) std::this_thread::yield();
+        }
+        close(tx);
+    });
+
+    uint8_t buffer[1500];
+    auto start = std::chrono::steady_clock::now();
+    auto last  = start;
+    ssize_t length;
+    while ((length = recv(rx, buffer, sizeof(buffer), 0)) > 0) {
+        receiver.handlePacket(buffer, length);
+        last = std::chrono::steady_clock::now();
+    }
+    sender.join();
+    close(rx);
+    report(name, receiver, last - start);
+}
+
+int main() {
+    printf("%d pixels, %d universes, %d frames\n\n", PIXELS, UNIVERSES, FRAMES);
+
+    benchmarkMemory("E1.31 (memory)",     buildE131,   1);
+    benchmarkMemory("Art-Net (memory)",   buildArtNet, 0);
+    benchmarkMemory("DDP (memory)",       buildDDP,    1);
+
+    benchmarkLoopback("E1.31 (loopback)",   buildE131,   1, HMS_STATUSLED_E131_PORT);
+    benchmarkLoopback("Art-Net (loopback)", buildArtNet, 0, HMS_STATUSLED_ARTNET_PORT);
+    benchmarkLoopback("DDP (loopback)",     buildDDP,    1, HMS_STATUSLED_DDP_PORT);
+
+    return 0;
+}
@@ -0,0 +1,93 @@
+/*
+ ====================================================================================================
+ * HMS StatusLED Driver - Table Encode Mode Benchmark (Linux host)
+ *
+ * Runs the same random writes, fills, brightness steps and power budget on two strips, one in table
+ * encode mode, and checks that every captured frame is identical. Both strips carry dimmed segments,
+ * which take the per channel path of table mode. Then times a brightness step plus show() with and
+ * without the table.
+ *
+ * Build: g++ -std=c++17 -O2 -DHMS_STATUSLED_HOST -Iinclude src/HMS_StatusLED_DRIVER.cpp \
+ *            examples/Other/host_table_encode_benchmark.cpp -o table_encode_benchmark
+ ====================================================================================================
+ */
+
+#include "HMS_StatusLED_DRIVER.h"
+
+#include <chrono>
+#include <stdlib.h>
+
+#define PIXELS          300
+#define STEPS           5000
+#define FRAMES          20000
+
+static void addSegments(HMS_StatusLED &led) {
+    uint8_t segmentId;
+    led.addSegment(10, 30, HMS_STATUSLED_ORDER_RGB, HMS_STATUSLED_SEGMENT_REVERSED, &segmentId);
+    led.segment(segmentId).setBrightness(128);
+    led.addSegment(60, 20, HMS_STATUSLED_ORDER_GRB, HMS_STATUSLED_SEGMENT_NORMAL, &segmentId);
+    led.segment(segmentId).setBrightness(17);
+}
+
+static uint32_t compareFrames() {
+    HMS_StatusLED table(PIXELS, HMS_STATUSLED_TYPE_WS281XX, HMS_STATUSLED_ORDER_GRB);
+    HMS_StatusLED direct(PIXELS, HMS_STATUSLED_TYPE_WS281XX, HMS_STATUSLED_ORDER_GRB);
+    table.begin(80);
+    direct.begin(80);
+    table.setTableEncodeMode(true);
+    addSegments(table);
+    addSegments(direct);
+
+    uint32_t mismatches = 0;
+    srand(1);
+    for (uint32_t step = 0; step < STEPS; step++) {
+        uint32_t color = rand() & 0xFFFFFF;
+        switch (rand() % 6) {
+            case 0:
+            case 1:
+            case 2: {
+                uint16_t pixelIndex = rand() % PIXELS;
+                table.setPixelColor(color, pixelIndex);
+                direct.setPixelColor(color, pixelIndex);
+                break;
+            }
+            case 3:     table.setBrightness(color & 0xFF);  direct.setBrightness(color & 0xFF);     break;
+            case 4:     table.fill(color);                  direct.fill(color);                     break;
+            default:
+                if (step == STEPS / 2) {                                                            // Power limit from here on
+                    table.setPowerBudget(1500);
+                    direct.setPowerBudget(1500);
+                }
+                break;
+        }
+        table.show();
+        direct.show();
+        if (table.getCapturedFrame() != direct.getCapturedFrame()) mismatches++;
+    }
+    return mismatches;
+}
+
+static double usPerStep(bool tableMode) {
+    HMS_StatusLED led(PIXELS, HMS_STATUSLED_TYPE_WS281XX, HMS_STATUSLED_ORDER_GRB);
+    led.begin(80);
+    led.setTableEncodeMode(tableMode);
+    for (uint16_t i = 0; i < PIXELS; i++) led.setPixelColor(HMS_StatusLED::colorHSV(i), i);
+
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t frame = 0; frame < FRAMES; frame++) {
+        led.setBrightness(frame | 1);
+        led.show();
+    }
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / FRAMES;
+}
+
+int main() {
+    uint32_t mismatches = compareFrames();
+    printf("%d steps, frames differing from the default path: %lu\n\n", STEPS, (unsigned long)mismatches);
+
+    printf("%d pixels, us per brightness step + show()\n", PIXELS);
+    printf("%-10s %10.2f\n", "default", usPerStep(false));
+    printf("%-10s %10.2f\n", "table", usPerStep(true));
+
+    return mismatches ? 1 : 0;
+}
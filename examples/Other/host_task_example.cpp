@@ -0,0 +1,73 @@
+/*
+ ====================================================================================================
+ * HMS StatusLED Driver - LED Task Example (Linux host)
+ *
+ * Runs the concurrency mode on the host backend: the LED task is a std::thread, four producer threads
+ * post pixels and show requests into the command queue at full speed while the task renders at most
+ * 30 frames per second. The last captured frame is compared against a second driver that got the same
+ * pixels through the direct API. Returns non-zero when the frames differ.
+ *
+ * Needs HMS_STATUSLED_CONCURRENCY_ENABLED set to 1 in HMS_StatusLED_Config.h.
+ *
+ * Build: g++ -std=c++17 -O2 -DHMS_STATUSLED_HOST -Iinclude src/HMS_StatusLED_DRIVER.cpp \
+ *            examples/Other/host_task_example.cpp -o task_example -lpthread
+ ====================================================================================================
+ */
+
+#include "HMS_StatusLED_DRIVER.h"
+
+#if !defined(HMS_STATUSLED_HAS_COMMAND_QUEUE)
+  #error "Set HMS_STATUSLED_CONCURRENCY_ENABLED to 1 in HMS_StatusLED_Config.h"
+#endif
+
+#define PIXELS          64
+#define PRODUCERS       4
+#define ROUNDS          500
+
+static uint32_t pixelColor(uint16_t pixel, uint16_t round) {
+    return ((uint32_t)(pixel * 4) << 16) | ((uint32_t)(round & 0xFF) << 8) | (uint32_t)(255 - pixel);
+}
+
+int main() {
+    HMS_StatusLED led(PIXELS, HMS_STATUSLED_TYPE_WS281XX, HMS_STATUSLED_ORDER_GRB);
+    led.begin(80);
+    led.setMaxFps(30);
+    led.startTask();
+
+    std::vector<std::thread> producers;
+    for (uint8_t producer = 0; producer < PRODUCERS; producer++) {
+        producers.emplace_back([&led, producer] {
+            const uint16_t first = producer * (PIXELS / PRODUCERS);
+            for (uint16_t round = 0; round < ROUNDS; round++) {
+                for (uint16_t pixel = first; pixel < first + PIXELS / PRODUCERS; pixel++) {
+                    while (led.postPixelColor(pixelColor(pixel, round), pixel) != HMS_STATUSLED_OK) {
+                        std::this_thread::yield();                              // Queue full, let the LED task catch up
+                    }
+                }
+                while (led.postShow() != HMS_STATUSLED_OK) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (std::thread &producer : producers) producer.join();
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));                // Longer than one frame slot, the last show is rendered
+    led.stopTask();
+
+    HMS_StatusLED reference(PIXELS, HMS_STATUSLED_TYPE_WS281XX, HMS_STATUSLED_ORDER_GRB);
+    reference.begin(80);
+    for (uint16_t pixel = 0; pixel < PIXELS; pixel++) reference.setPixelColor(pixelColor(pixel, ROUNDS - 1), pixel);
+    reference.show();
+
+    const uint32_t shows = PRODUCERS * ROUNDS;
+    bool ok = led.getCapturedFrame() == reference.getCapturedFrame();
+
+    printf("Show requests:   %lu\n", (unsigned long)shows);
+    printf("Frames rendered: %lu\n", (unsigned long)(shows - led.getCoalescedFrames()));
+    printf("Coalesced:       %lu\n", (unsigned long)led.getCoalescedFrames());
+    printf("Dropped posts:   %lu (retried)\n", (unsigned long)led.getDroppedCommands());
+    printf("Last frame:      %s\n", ok ? "ok" : "FAIL");
+
+    return ok ? 0 : 1;
+}
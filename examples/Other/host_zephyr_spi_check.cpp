@@ -0,0 +1,59 @@
+/*
+ ====================================================================================================
+ * HMS StatusLED Driver - Zephyr SPI Waveform Check (Linux host)
+ *
+ * Takes the SPI clock and 0/1 byte patterns the Zephyr backend derives for every built-in timing
+ * profile (getSPIPatterns(), the same code begin() runs), sends all 256 byte values through them as
+ * one SPI stream and decodes it with HMS_StatusLED_WireDecoder. Pulse widths are held to
+ * HMS_STATUSLED_VERIFY_TOLERANCE_NS, the bit period to the ±600ns of the datasheets (8MHz SPI gives
+ * 1000ns bits for a 1250ns profile). Returns non-zero when a byte or a bit does not decode.
+ *
+ * Build: g++ -std=c++17 -O2 -DHMS_STATUSLED_HOST -Iinclude src/HMS_StatusLED_DRIVER.cpp src/HMS_StatusLED_Verify.cpp \
+ *            examples/Other/host_zephyr_spi_check.cpp -o zephyr_spi_check
+ ====================================================================================================
+ */
+
+#include "HMS_StatusLED_Verify.h"
+
+#include <string.h>
+
+#define PERIOD_TOLERANCE_NS     600
+
+static const char* profileNames[] = {"WS281XX", "WS2811", "WS2811 400kHz", "WS2812B", "WS2813", "SK6812", "TM1814"};
+
+int main() {
+    uint8_t values[256];
+    for (int i = 0; i < 256; i++) values[i] = (uint8_t)i;
+
+    printf("%-14s %8s %6s %6s %10s %10s %12s %7s  %s\n", "Profile", "SPI", "Zero", "One", "T0H", "T1H", "Period", "Margin", "Result");
+
+    int failures = 0;
+    for (uint8_t type = HMS_STATUSLED_TYPE_WS281XX; type < HMS_STATUSLED_TYPE_CUSTOM; type++) {
+        const HMS_StatusLED_Timing& timing = HMS_StatusLED::getTimingProfile((HMS_StatusLED_Type)type);
+
+        uint8_t  pulse0, pulse1;
+        uint32_t spiHz = HMS_StatusLED::getSPIPatterns(timing, pulse0, pulse1);
+
+        std::vector<uint8_t> stream;                                                // One SPI byte per LED bit, MSB first like encodeByte()
+        for (uint8_t value : values) {
+            for (int8_t bit = 7; bit >= 0; bit--) stream.push_back((value & (1 << bit)) ? pulse1 : pulse0);
+        }
+
+        HMS_StatusLED_WireDecoder decoder(timing, HMS_STATUSLED_VERIFY_TOLERANCE_NS, PERIOD_TOLERANCE_NS);
+        decoder.addSPIStream(stream.data(), stream.size(), spiHz);
+        decoder.addIdle(timing.resetUs * 1000);                                     // Latch gap waited out by transmit()
+
+        uint8_t decoded[256];
+        HMS_StatusLED_WireReport report = decoder.decode(decoded, sizeof(decoded));
+
+        bool ok = report.bytes == 256 && report.invalidBits == 0 && report.resetOk && memcmp(decoded, values, 256) == 0;
+        if (!ok) failures++;
+
+        printf("%-14s %5luMHz   0x%02X   0x%02X %4lu-%-4lu  %4lu-%-4lu %5lu-%-5lu %6ldns  %s\n", profileNames[type],
+               (unsigned long)(spiHz / 1000000), pulse0, pulse1,
+               (unsigned long)report.t0hMinNs, (unsigned long)report.t0hMaxNs, (unsigned long)report.t1hMinNs, (unsigned long)report.t1hMaxNs,
+               (unsigned long)report.periodMinNs, (unsigned long)report.periodMaxNs, (long)report.marginNs, ok ? "ok" : "FAIL");
+    }
+
+    return failures ? 1 : 0;
+}
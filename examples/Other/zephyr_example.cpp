@@ -0,0 +1,68 @@
+/*
+ ====================================================================================================
+ * HMS StatusLED Driver - Zephyr Usage Example
+ * 
+ * This example shows how to use the HMS StatusLED Driver with Zephyr (e.g. nRF52)
+ * The LED data line is driven by SPI MOSI, each LED bit is sent as one SPI byte at 8MHz (1000ns bits)
+ * Frames are sent asynchronously when CONFIG_SPI_ASYNC is enabled
+ * The SPI waveform of every timing profile is checked on the host by host_zephyr_spi_check.cpp
+ ====================================================================================================
+ */
+
+#include <zephyr/kernel.h>
+#include "HMS_StatusLED_DRIVER.h"
+
+// SPI controller whose MOSI pin is wired to the LED data input (see overlay below)
+static const struct device *ledSpi = DEVICE_DT_GET(DT_NODELABEL(spi1));
+
+// Create HMS StatusLED instance
+// Parameters: maxPixels, ledType, colorOrder
+HMS_StatusLED led(8, HMS_STATUSLED_TYPE_WS281XX, HMS_STATUSLED_ORDER_GRB);
+
+int main(void) {
+    // Initialize the driver with the SPI controller
+    if (led.begin(ledSpi) != HMS_STATUSLED_OK) {
+        printk("Failed to initialize LED driver!\n");
+        return 0;
+    }
+
+    led.clear();
+    led.show();
+
+    while (1) {
+        led.fill(HMS_STATUSLED_RGB888_GREEN);       // Status OK
+        led.show();                                 // Returns once the frame is queued on the SPI bus
+        k_msleep(500);
+
+        led.turnOff();
+        led.show();
+        k_msleep(500);
+
+        led.turnOn();
+    }
+
+    return 0;
+}
+
+/*
+ ====================================================================================================
+ * Zephyr Configuration Requirements:
+ * 
+ * prj.conf:
+ *   CONFIG_CPP=y
+ *   CONFIG_STD_CPP17=y
+ *   CONFIG_REQUIRES_FULL_LIBCPP=y
+ *   CONFIG_SPI=y
+ *   CONFIG_SPI_ASYNC=y                  # Optional, show() returns before the frame is on the wire
+ * 
+ * Board overlay (nRF52, MOSI on P0.13, SCK/MISO unused by the LEDs):
+ *   &spi1 {
+ *       status = "okay";
+ *       pinctrl-0 = <&spi1_default>;
+ *       pinctrl-1 = <&spi1_sleep>;
+ *       pinctrl-names = "default", "sleep";
+ *   };
+ * 
+ * The SPI MOSI line must idle low between frames; add a pull-down if the controller floats it.
+ ====================================================================================================
+ */
@@ -14,14 +14,14 @@ void testBrightness();
 void testOnOffFeature();
 void testIndividualLEDs();
 void testBreathingEffect();
-uint32_t wheel(uint8_t wheelPos);
+void testEffectKernels();
 
 void setup() {
   Serial.begin(115200);
   statusLEDLogger.info("=== HMS StatusLED Driver Example ===");
   statusLEDLogger.info("Features: Colors, Effects, Brightness Control, On/Off");
 
-  if (led.begin(5, RMT_CHANNEL_0) != HMS_STATUSLED_OK) {
+  if (led.begin(5) != HMS_STATUSLED_OK) {
     statusLEDLogger.error("Failed to initialize LED driver!");
     return;
   }
@@ -59,6 +59,7 @@ void loop() {
     testBrightness();       delay(1000);                                                                    // Test 6: NEW - Brightness control
     testOnOffFeature();     delay(1000);                                                                    // Test 7: NEW - On/Off feature
     testBreathingEffect();  delay(1000);                                                                    // Test 8: NEW - Breathing effect (combines brightness + color)
+    testEffectKernels();    delay(1000);                                                                    // Test 9: NEW - Built-in effect kernels
 
     statusLEDLogger.info("=== LED Test Sequence Complete ===");
     delay(3000);                                                                                            // Wait 3 seconds before repeating
@@ -141,10 +142,7 @@ void rainbowEffect() {
     
     for (int cycle = 0; cycle < 2; cycle++) {
         for (int hue = 0; hue < 256; hue += 4) {
-            for (int i = 0; i < 30; i++) {
-                uint32_t color = wheel((hue + i * 8) & 255);
-                led.setPixelColor(color, i);
-            }
+            led.fillRainbow(0, 30, hue, 8);                                                                 // Integer HSV in the driver, 8 hue steps per LED
             led.show();
             delay(50);
         }
@@ -154,10 +152,7 @@ void rainbowEffect() {
 void testBrightness() {
     statusLEDLogger.info("Testing brightness control...");
     
-    for (int i = 0; i < 30; i++) {                                                                          // Set all LEDs to a nice rainbow pattern first
-        uint32_t color = wheel((i * 8) & 255);
-        led.setPixelColor(color, i);
-    }
+    led.fillRainbow(0, 30, 0, 8);                                                                           // Set all LEDs to a nice rainbow pattern first
     
     statusLEDLogger.info("Full brightness (255)");                                                          // Test different brightness levels
     led.setBrightness(255);
@@ -215,10 +210,7 @@ void testOnOffFeature() {
     led.setPixelColor(HMS_STATUSLED_RGB_TO_888(0, 255, 255), 6);                                            // Cyan
     led.setPixelColor(HMS_STATUSLED_RGB_TO_888(255, 255, 255), 7);                                          // White
 
-    for (int i = 8; i < 30; i++) {
-        uint32_t color = wheel((i * 16) & 255);
-        led.setPixelColor(color, i);
-    }
+    led.fillRainbow(8, 22, 128, 16);
     
     statusLEDLogger.info("Showing colorful pattern...");
     led.show();
@@ -297,15 +289,33 @@ void testBreathingEffect() {
     led.show();
 }
 
-uint32_t wheel(uint8_t wheelPos) {
-    wheelPos = 255 - wheelPos;
-    if (wheelPos < 85) {
-        return HMS_STATUSLED_RGB_TO_888(255 - wheelPos * 3, 0, wheelPos * 3);
+void testEffectKernels() {
+    statusLEDLogger.info("Running built-in effect kernels...");
+
+    const HMS_StatusLED_Effect effects[] = {                                                                // type, color, background, period ms, size
+        { HMS_STATUSLED_EFFECT_BREATHE, HMS_STATUSLED_RGB888_BLUE,                0x000000, 2000,   0 },
+        { HMS_STATUSLED_EFFECT_SCANNER, HMS_STATUSLED_RGB888_RED,                 0x000000, 2000,   4 },
+        { HMS_STATUSLED_EFFECT_COMET,   HMS_STATUSLED_RGB_TO_888(255, 100, 0),    0x000000, 1500,   8 },
+        { HMS_STATUSLED_EFFECT_SPARKLE, HMS_STATUSLED_RGB_TO_888(255, 255, 255),  0x000008,  400,  24 },
+        { HMS_STATUSLED_EFFECT_FIRE,    0x000000,                                 0x000000,   80, 160 },
+    };
+
+    for (const HMS_StatusLED_Effect &effect : effects) {
+        uint32_t start = millis();
+        while (millis() - start < 4000) {                                                                   // No delay() inside the effect, the kernel follows the clock
+            led.renderEffect(effect, millis());
+            led.show();
+        }
     }
-    if (wheelPos < 170) {
-        wheelPos -= 85;
-        return HMS_STATUSLED_RGB_TO_888(0, wheelPos * 3, 255 - wheelPos * 3);
+
+    HMS_StatusLED_Effect progress = { HMS_STATUSLED_EFFECT_PROGRESS, HMS_STATUSLED_RGB888_GREEN, 0x080000, 0, 0 };
+    for (int level = 0; level <= 255; level += 5) {
+        progress.size = level;
+        led.renderEffect(progress, millis());
+        led.show();
+        delay(40);
     }
-    wheelPos -= 170;
-    return HMS_STATUSLED_RGB_TO_888(wheelPos * 3, 255 - wheelPos * 3, 0);
-}
\ No newline at end of file
+
+    led.clear();
+    led.show();
+}
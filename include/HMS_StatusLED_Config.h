@@ -45,6 +45,17 @@
   └─────────────────────────────────────────────────────────────────────┘
 */
 #define HMS_STATUSLED_DEBUG_ENABLED           0                                 // Enable debug messages (1=enabled, 0=disabled)
+#define HMS_STATUSLED_LOG_LEVEL               3                                 // Messages compiled in (1=errors, 2=+info, 3=+debug), lower levels cost nothing
+
+/*
+  ┌─────────────────────────────────────────────────────────────────────┐
+  │ Note:     Deferred binary trace for hot paths (show, pixel writes)  │
+  │ Usage:    Records are 12 bytes, formatted later by dumpTrace() or   │
+  │           by a host-side decoder reading readTrace() output         │
+  └─────────────────────────────────────────────────────────────────────┘
+*/
+#define HMS_STATUSLED_TRACE_ENABLED           0                                 // Record trace events (1=enabled, 0=compiled out)
+#define HMS_STATUSLED_TRACE_DEPTH             256                               // Records kept in the ring, oldest are overwritten (power of two)
 
 /*
     ┌───────────────────────────────────────────────────────────────────┐
@@ -61,53 +72,105 @@
 #define HMS_STATUSLED_PULSE_LENGTH_NS      1250                                 // Pulse length in nanoseconds (typically 1250ns for WS2812B)
 #define HMS_STATUSLED_PULSE_0_NS           400
 #define HMS_STATUSLED_PULSE_1_NS           800
+#define HMS_STATUSLED_RESET_US             50                                   // Minimum low time between frames to latch the data (µs)
 #define HMS_STATUSLED_GAMMA                true                                 // Enable gamma correction (true/false)
 #define HMS_STATUSLED_DEFAULT_COLOR_ORDER  HMS_STATUSLED_ORDER_RGB              // Default color order (RGB, BGR, GRB)
+#define HMS_STATUSLED_MAX_SEGMENTS         8                                    // Maximum number of segments (virtual strips) per instance
+#define HMS_STATUSLED_MAX_CACHED_FRAMES    4                                    // Number of pre-encoded frame slots for showCached() (RAM: one encoded frame each)
+#define HMS_STATUSLED_DEFAULT_MA_PER_CHANNEL 20                                 // Current drawn by one color channel at full duty (mA), used by the power limiter
+#define HMS_STATUSLED_MAX_LAYERS           4                                    // Maximum number of RGBA compositing layers (RAM: 4 bytes per pixel per layer in use)
+#define HMS_STATUSLED_MAX_STATES           4                                    // Saved states per instance (saveState() ids, also used by pushState())
+#define HMS_STATUSLED_STATE_BLOCK_PIXELS   16                                   // Pixels per copy-on-write block of saved states (RAM: 3 bytes per pixel per preserved block)
+#define HMS_STATUSLED_VERIFY_TOLERANCE_NS  150                                  // Allowed deviation of T0H/T1H/period for HMS_StatusLED_WireDecoder (datasheet: ±150ns)
+#define HMS_STATUSLED_STREAM_MAX_UNIVERSES 32                                   // E1.31 / Art-Net universes one stream receiver maps onto the strip (at most 32)
+
+/*
+    ┌───────────────────────────────────────────────────────────────────┐
+    │ Note:    ESP32 RMT backend                                        │
+    │ Usage:   ESP-IDF 5+ uses the RMT TX driver with a bytes encoder,  │
+    │          set LEGACY_DRIVER to 1 to use driver/rmt.h instead       │
+    └───────────────────────────────────────────────────────────────────┘
+*/
+
+#define HMS_STATUSLED_RMT_LEGACY_DRIVER    0                                    // 1 = legacy driver/rmt.h (always used before ESP-IDF 5)
+#define HMS_STATUSLED_RMT_RESOLUTION_HZ    40000000                             // RMT tick rate (25ns per tick)
+#define HMS_STATUSLED_RMT_WITH_DMA         1                                    // Stream through DMA where the target has it (ESP32-S3), falls back otherwise
+#define HMS_STATUSLED_RMT_MEM_BLOCK_SYMBOLS 1024                                // Symbols buffered per channel with DMA (64 are used without DMA)
+
+/*
+    ┌───────────────────────────────────────────────────────────────────┐
+    │ Note:    Zephyr SPI backend                                       │
+    │ Usage:   The SPI clock is this maximum divided by a power of two, │
+    │          the one whose byte length is closest to the LED bit      │
+    └───────────────────────────────────────────────────────────────────┘
+*/
+
+#define HMS_STATUSLED_SPI_MAX_HZ           8000000                              // Fastest SPI clock of the controller (nRF52 SPIM: 8MHz, 125kHz steps of powers of two)
+
+/*
+  ┌─────────────────────────────────────────────────────────────────────┐
+  │ Note:     Concurrency mode (ESP32 FreeRTOS / Zephyr / host)         │
+  │           Other tasks and ISRs post commands, one LED task owns     │
+  │           the pixel buffers and the peripheral                      │
+  └─────────────────────────────────────────────────────────────────────┘
+*/
+
+#define HMS_STATUSLED_CONCURRENCY_ENABLED  0                                    // Enable the command queue and LED task (1=enabled, 0=disabled)
+#define HMS_STATUSLED_COMMAND_QUEUE_SIZE   64                                   // Commands buffered between producers and the LED task (power of two)
+#define HMS_STATUSLED_TASK_STACK_SIZE      4096                                 // LED task stack in bytes (FreeRTOS, Zephyr takes the stack from startTask())
+#define HMS_STATUSLED_TASK_PRIORITY        5                                    // LED task priority (not used by the host std::thread)
+#define HMS_STATUSLED_MAX_FPS              60                                   // Frame rate cap of the LED task, show requests in between are coalesced (0 = no cap)
+#define HMS_STATUSLED_HDR_REFRESH_HZ       240                                  // Dither frames per second the LED task sends in HDR mode while no show is pending
 
 /*
   ┌─────────────────────────────────────────────────────────────────────┐
   │ Note:     RGB565 color definitions (16-bit format)                  │
   │           VS Code will show color previews for these hex values     │
+  │           Tagged with HMS_STATUSLED_565() so setPixelColor() can    │
+  │           tell them apart from RGB888 values                        │
   └─────────────────────────────────────────────────────────────────────┘
 */
 
-#define HMS_STATUSLED_RGB565_RED           0xF800      // #FF0000 → 255,   0,   0
-#define HMS_STATUSLED_RGB565_TAN           0xD5B1      // #D2B48C → 210, 180, 140
-#define HMS_STATUSLED_RGB565_GRAY          0x8410      // #808080 → 128, 128, 128
-#define HMS_STATUSLED_RGB565_GOLD          0xFEA0      // #FFD700 → 255, 215,   0
-#define HMS_STATUSLED_RGB565_BLUE          0x001F      // #0000FF →   0,   0, 255
-#define HMS_STATUSLED_RGB565_CYAN          0x07FF      // #00FFFF →   0, 255, 255
-#define HMS_STATUSLED_RGB565_PINK          0xFC18      // #FFC0CB → 255, 192, 203
-#define HMS_STATUSLED_RGB565_TEAL          0x0410      // #008080 →   0, 128, 128
-#define HMS_STATUSLED_RGB565_LIME          0x07E0      // #00FF00 →   0, 255,   0
-#define HMS_STATUSLED_RGB565_AQUA          0x07FF      // #00FFFF →   0, 255, 255
-#define HMS_STATUSLED_RGB565_NAVY          0x000F      // #000080 →   0,   0, 128
-#define HMS_STATUSLED_RGB565_OLIVE         0x8400      // #808000 → 128, 128,   0
-#define HMS_STATUSLED_RGB565_BLACK         0x0000      // #000000 →   0,   0,   0
-#define HMS_STATUSLED_RGB565_WHITE         0xFFFF      // #FFFFFF → 255, 255, 255
-#define HMS_STATUSLED_RGB565_GREEN         0x07E0      // #00FF00 →   0, 255,   0
-#define HMS_STATUSLED_RGB565_BROWN         0xA145      // #A52A2A → 165,  42,  42
-#define HMS_STATUSLED_RGB565_CORAL         0xFBEA      // #FF7F50 → 255, 127,  80
-#define HMS_STATUSLED_RGB565_INDIGO        0x4810      // #4B0082 →  75,   0, 130
-#define HMS_STATUSLED_RGB565_TOMATO        0xFB08      // #FF6347 → 255,  99,  71
-#define HMS_STATUSLED_RGB565_SILVER        0xC618      // #C0C0C0 → 192, 192, 192
-#define HMS_STATUSLED_RGB565_VIOLET        0x8A16      // #8A2BE2 → 138,  43, 226
-#define HMS_STATUSLED_RGB565_MAROON        0x7800      // #800000 → 128,   0,   0
-#define HMS_STATUSLED_RGB565_YELLOW        0xFFE0      // #FFFF00 → 255, 255,   0
-#define HMS_STATUSLED_RGB565_ORANGE        0xFD20      // #FFA500 → 255, 165,   0
-#define HMS_STATUSLED_RGB565_PURPLE        0x780F      // #800080 → 128,   0, 128
-#define HMS_STATUSLED_RGB565_DIMGRAY       0x6B4D      // #696969 → 105, 105, 105
-#define HMS_STATUSLED_RGB565_CRIMSON       0xD8A7      // #DC143C → 220,  20,  60
-#define HMS_STATUSLED_RGB565_MAGENTA       0xF81F      // #FF00FF → 255,   0, 255
-#define HMS_STATUSLED_RGB565_SKYBLUE       0x867D      // #87CEEB → 135, 206, 235
-#define HMS_STATUSLED_RGB565_LAVENDER      0xE73F      // #E6E6FA → 230, 230, 250
-#define HMS_STATUSLED_RGB565_SEAGREEN      0x2E5B      // #2E8B57 →  46, 139,  87
-#define HMS_STATUSLED_RGB565_CHOCOLATE     0xD343      // #D2691E → 210, 105,  30
-#define HMS_STATUSLED_RGB565_FIREBRICK     0xB104      // #B22222 → 178,  34,  34
-#define HMS_STATUSLED_RGB565_SLATEGRAY     0x7412      // #708090 → 112, 128, 144
-#define HMS_STATUSLED_RGB565_DARKORANGE    0xFC60      // #FF8C00 → 255, 140,   0
-#define HMS_STATUSLED_RGB565_FORESTGREEN   0x2444      // #228B22 →  34, 139,  34
-#define HMS_STATUSLED_RGB565_DARKSLATEGRAY 0x2A69      // #2F4F4F →  47,  79,  79
+#define HMS_STATUSLED_COLOR_565_FLAG       0x01000000                           // Above the RGB888 range, marks a 32-bit color value as RGB565
+#define HMS_STATUSLED_565(RGB565)          (HMS_STATUSLED_COLOR_565_FLAG | ((uint32_t)(RGB565) & 0xFFFF))
+
+#define HMS_STATUSLED_RGB565_RED           HMS_STATUSLED_565(0xF800)  // #FF0000 → 255,   0,   0
+#define HMS_STATUSLED_RGB565_TAN           HMS_STATUSLED_565(0xD5B1)  // #D2B48C → 210, 180, 140
+#define HMS_STATUSLED_RGB565_GRAY          HMS_STATUSLED_565(0x8410)  // #808080 → 128, 128, 128
+#define HMS_STATUSLED_RGB565_GOLD          HMS_STATUSLED_565(0xFEA0)  // #FFD700 → 255, 215,   0
+#define HMS_STATUSLED_RGB565_BLUE          HMS_STATUSLED_565(0x001F)  // #0000FF →   0,   0, 255
+#define HMS_STATUSLED_RGB565_CYAN          HMS_STATUSLED_565(0x07FF)  // #00FFFF →   0, 255, 255
+#define HMS_STATUSLED_RGB565_PINK          HMS_STATUSLED_565(0xFC18)  // #FFC0CB → 255, 192, 203
+#define HMS_STATUSLED_RGB565_TEAL          HMS_STATUSLED_565(0x0410)  // #008080 →   0, 128, 128
+#define HMS_STATUSLED_RGB565_LIME          HMS_STATUSLED_565(0x07E0)  // #00FF00 →   0, 255,   0
+#define HMS_STATUSLED_RGB565_AQUA          HMS_STATUSLED_565(0x07FF)  // #00FFFF →   0, 255, 255
+#define HMS_STATUSLED_RGB565_NAVY          HMS_STATUSLED_565(0x000F)  // #000080 →   0,   0, 128
+#define HMS_STATUSLED_RGB565_OLIVE         HMS_STATUSLED_565(0x8400)  // #808000 → 128, 128,   0
+#define HMS_STATUSLED_RGB565_BLACK         HMS_STATUSLED_565(0x0000)  // #000000 →   0,   0,   0
+#define HMS_STATUSLED_RGB565_WHITE         HMS_STATUSLED_565(0xFFFF)  // #FFFFFF → 255, 255, 255
+#define HMS_STATUSLED_RGB565_GREEN         HMS_STATUSLED_565(0x07E0)  // #00FF00 →   0, 255,   0
+#define HMS_STATUSLED_RGB565_BROWN         HMS_STATUSLED_565(0xA145)  // #A52A2A → 165,  42,  42
+#define HMS_STATUSLED_RGB565_CORAL         HMS_STATUSLED_565(0xFBEA)  // #FF7F50 → 255, 127,  80
+#define HMS_STATUSLED_RGB565_INDIGO        HMS_STATUSLED_565(0x4810)  // #4B0082 →  75,   0, 130
+#define HMS_STATUSLED_RGB565_TOMATO        HMS_STATUSLED_565(0xFB08)  // #FF6347 → 255,  99,  71
+#define HMS_STATUSLED_RGB565_SILVER        HMS_STATUSLED_565(0xC618)  // #C0C0C0 → 192, 192, 192
+#define HMS_STATUSLED_RGB565_VIOLET        HMS_STATUSLED_565(0x8A16)  // #8A2BE2 → 138,  43, 226
+#define HMS_STATUSLED_RGB565_MAROON        HMS_STATUSLED_565(0x7800)  // #800000 → 128,   0,   0
+#define HMS_STATUSLED_RGB565_YELLOW        HMS_STATUSLED_565(0xFFE0)  // #FFFF00 → 255, 255,   0
+#define HMS_STATUSLED_RGB565_ORANGE        HMS_STATUSLED_565(0xFD20)  // #FFA500 → 255, 165,   0
+#define HMS_STATUSLED_RGB565_PURPLE        HMS_STATUSLED_565(0x780F)  // #800080 → 128,   0, 128
+#define HMS_STATUSLED_RGB565_DIMGRAY       HMS_STATUSLED_565(0x6B4D)  // #696969 → 105, 105, 105
+#define HMS_STATUSLED_RGB565_CRIMSON       HMS_STATUSLED_565(0xD8A7)  // #DC143C → 220,  20,  60
+#define HMS_STATUSLED_RGB565_MAGENTA       HMS_STATUSLED_565(0xF81F)  // #FF00FF → 255,   0, 255
+#define HMS_STATUSLED_RGB565_SKYBLUE       HMS_STATUSLED_565(0x867D)  // #87CEEB → 135, 206, 235
+#define HMS_STATUSLED_RGB565_LAVENDER      HMS_STATUSLED_565(0xE73F)  // #E6E6FA → 230, 230, 250
+#define HMS_STATUSLED_RGB565_SEAGREEN      HMS_STATUSLED_565(0x2E5B)  // #2E8B57 →  46, 139,  87
+#define HMS_STATUSLED_RGB565_CHOCOLATE     HMS_STATUSLED_565(0xD343)  // #D2691E → 210, 105,  30
+#define HMS_STATUSLED_RGB565_FIREBRICK     HMS_STATUSLED_565(0xB104)  // #B22222 → 178,  34,  34
+#define HMS_STATUSLED_RGB565_SLATEGRAY     HMS_STATUSLED_565(0x7412)  // #708090 → 112, 128, 144
+#define HMS_STATUSLED_RGB565_DARKORANGE    HMS_STATUSLED_565(0xFC60)  // #FF8C00 → 255, 140,   0
+#define HMS_STATUSLED_RGB565_FORESTGREEN   HMS_STATUSLED_565(0x2444)  // #228B22 →  34, 139,  34
+#define HMS_STATUSLED_RGB565_DARKSLATEGRAY HMS_STATUSLED_565(0x2A69)  // #2F4F4F →  47,  79,  79
 
 
 /*
@@ -167,10 +230,10 @@
 #define HMS_STATUSLED_RGB_TO_565(R, G, B)    (((((uint16_t)(R)) & 0xF8) << 8) | ((((uint16_t)(G)) & 0xFC) << 3) | (((uint16_t)(B)) >> 3))
 #define HMS_STATUSLED_RGB_TO_888(R, G, B)    ((((uint32_t)(R)) << 16) | (((uint32_t)(G)) << 8) | ((uint32_t)(B)))
 
-// RGB565 to RGB888 Conversion (Expanding 5-6-5 bits to 8-8-8 bits)
-#define HMS_STATUSLED_565_TO_888(RGB565)     (((((RGB565) & 0xF800) >> 8) | (((RGB565) & 0xE000) >> 13)) << 16) | \
-                                             (((((RGB565) & 0x07E0) >> 3) | (((RGB565) & 0x0600) >> 9)) << 8) | \
-                                             (((RGB565) & 0x001F) << 3) | (((RGB565) & 0x001C) >> 2)
+// RGB565 to RGB888 Conversion (Expanding 5-6-5 bits to 8-8-8 bits by bit replication)
+#define HMS_STATUSLED_565_TO_888(RGB565)     ((((((RGB565) & 0xF800) >> 8) | (((RGB565) & 0xE000) >> 13)) << 16) | \
+                                              (((((RGB565) & 0x07E0) >> 3) | (((RGB565) & 0x0600) >> 9)) << 8) | \
+                                              (((RGB565) & 0x001F) << 3) | (((RGB565) & 0x001C) >> 2))
 
 // RGB888 to RGB565 Conversion (Reducing 8-8-8 bits to 5-6-5 bits)
 #define HMS_STATUSLED_888_TO_565(RGB888)     ((((RGB888) & 0xF80000) >> 8) | (((RGB888) & 0x00FC00) >> 5) | (((RGB888) & 0x0000F8) >> 3))
@@ -180,9 +243,9 @@
 #define HMS_STATUSLED_GET_GREEN_888(RGB888)  (((RGB888) >> 8) & 0xFF)
 #define HMS_STATUSLED_GET_BLUE_888(RGB888)   ((RGB888) & 0xFF)
 
-#define HMS_STATUSLED_GET_RED_565(RGB565)    (((RGB565) >> 8) & 0xF8)
-#define HMS_STATUSLED_GET_GREEN_565(RGB565)  (((RGB565) >> 3) & 0xFC)
-#define HMS_STATUSLED_GET_BLUE_565(RGB565)   (((RGB565) << 3) & 0xF8)
+#define HMS_STATUSLED_GET_RED_565(RGB565)    ((((RGB565) >> 8) & 0xF8) | (((RGB565) >> 13) & 0x07))       // Top bits replicated into the low bits, 0x1F → 0xFF
+#define HMS_STATUSLED_GET_GREEN_565(RGB565)  ((((RGB565) >> 3) & 0xFC) | (((RGB565) >> 9) & 0x03))
+#define HMS_STATUSLED_GET_BLUE_565(RGB565)   ((((RGB565) << 3) & 0xF8) | (((RGB565) >> 2) & 0x07))
 
 // Get Hex Values with 0x Prefix (Easy Access Macros)
 #define HMS_STATUSLED_HEX565(COLOR)          ((uint16_t)(COLOR))
@@ -218,11 +281,12 @@
   │ uint8_t red = HMS_STATUSLED_GET_RED_888(HMS_STATUSLED_RGB888_PURPLE);  │
   │ uint8_t green = HMS_STATUSLED_GET_GREEN_565(HMS_STATUSLED_RGB565_TEAL);│
   │                                                                        │
-  │ => SetPixelColor examples (auto-detects RGB565/RGB888):                │
-  │ led.setPixelColor(HMS_STATUSLED_RGB565_RED, 0);    // RGB565 detected  │
-  │ led.setPixelColor(HMS_STATUSLED_RGB888_BLUE, 1);   // RGB888 detected  │
+  │ => SetPixelColor examples (RGB888 unless tagged as RGB565):            │
+  │ led.setPixelColor(HMS_STATUSLED_RGB565_RED, 0);    // Tagged RGB565    │
+  │ led.setPixelColor(HMS_STATUSLED_RGB888_BLUE, 1);   // RGB888 blue      │
   │ led.setPixelColor(0xFF00FF, 2);                    // RGB888 magenta   │
-  │ led.setPixelColor(0xF81F, 3);                      // RGB565 magenta   │
+  │ led.setPixelColor(HMS_STATUSLED_565(0xF81F), 3);   // RGB565 magenta   │
+  │ led.setPixelColor565(0xF81F, 4);                   // No tag needed    │
   │                                                                        │
   │ => SetPixelColor with specific color order:                            │
   │ led.setPixelColor(0xFF0000, 0, HMS_STATUSLED_ORDER_RGB); // Red as RGB │
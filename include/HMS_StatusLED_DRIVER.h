@@ -12,6 +12,8 @@
   #define HMS_STATUSLED_PLATFORM_ZEPHYR
 #elif defined( __STM32__)
   #define HMS_STATUSLED_PLATFORM_STM32_HAL
+#elif defined(HMS_STATUSLED_HOST)
+  #define HMS_STATUSLED_PLATFORM_HOST                                                                      // Desktop build, a simulated timer + DMA captures the frames
 #endif
 
 #if defined(HMS_STATUSLED_PLATFORM_ARDUINO)
@@ -20,24 +22,40 @@
   #include <stdint.h>
   #include <Arduino.h>
   #if defined(HMS_STATUSLED_PLATFORM_ARDUINO_ESP32)
-    #include <driver/rmt.h>
+    #include <esp_idf_version.h>
+  #elif defined(ARDUINO_ARCH_RP2040)
+    #define HMS_STATUSLED_PLATFORM_ARDUINO_RP2040
+    #include <hardware/pio.h>
+    #include <hardware/dma.h>
+    #include <hardware/clocks.h>
+    #include <hardware/sync.h>
+  #elif defined(ARDUINO_ARCH_AVR) || defined(__AVR__)
+    #error "HMS_StatusLED: AVR is not supported, the driver needs the C++ standard library (<vector>) and more RAM than ATmega parts have"
+  #elif defined(ARDUINO_ARCH_SAMD)
+    #define HMS_STATUSLED_PLATFORM_ARDUINO_SAMD
   #endif
 #elif defined(HMS_STATUSLED_PLATFORM_ESP_IDF)
   #include <stdio.h>
   #include <stdint.h>
   #include <vector>
-  #include "driver/rmt.h"
+  #include "esp_idf_version.h"
 #elif defined(HMS_STATUSLED_PLATFORM_ZEPHYR)
   #include <vector>
   #include <stdio.h>
   #include <stdint.h>
   #include <zephyr/device.h>
-  #include <zephyr/drivers/i2c.h>
+  #include <zephyr/kernel.h>
+  #include <zephyr/drivers/spi.h>
 #elif defined(HMS_STATUSLED_PLATFORM_STM32_HAL)
   #include "main.h"
   #include <vector>
   #include <stdio.h>
   #include <stdint.h>
+#elif defined(HMS_STATUSLED_PLATFORM_HOST)
+  #include <vector>
+  #include <chrono>
+  #include <stdio.h>
+  #include <stdint.h>
 #endif
 
 #include "HMS_StatusLED_Config.h"
@@ -46,8 +64,49 @@
   #define HMS_STATUSLED_LOGGER_ENABLED
 #endif
 
+#if defined(HMS_STATUSLED_PLATFORM_ARDUINO_ESP32) || defined(HMS_STATUSLED_PLATFORM_ESP_IDF)
+  #if (HMS_STATUSLED_RMT_LEGACY_DRIVER == 1) || (ESP_IDF_VERSION_MAJOR < 5)
+    #define HMS_STATUSLED_ESP_RMT_LEGACY                                                                  // driver/rmt.h, pixels expanded to 24 RMT items each
+    #include "driver/rmt.h"
+    #include "freertos/FreeRTOS.h"
+    #include "esp_timer.h"
+  #else
+    #include "driver/rmt_tx.h"                                                                            // RMT TX channel + bytes encoder, pixels streamed as bytes
+    #include "freertos/FreeRTOS.h"
+    #include "freertos/semphr.h"
+    #include "esp_timer.h"
+    #include "esp_attr.h"
+  #endif
+#endif
+
+#if defined(HMS_STATUSLED_CONCURRENCY_ENABLED) && (HMS_STATUSLED_CONCURRENCY_ENABLED == 1)
+  #if defined(HMS_STATUSLED_PLATFORM_ARDUINO_ESP32) || defined(HMS_STATUSLED_PLATFORM_ESP_IDF)
+    #define HMS_STATUSLED_HAS_COMMAND_QUEUE                                                               // Command queue drained by a FreeRTOS task
+    #include <atomic>
+    #include "freertos/task.h"
+  #elif defined(HMS_STATUSLED_PLATFORM_ZEPHYR)
+    #define HMS_STATUSLED_HAS_COMMAND_QUEUE                                                               // Command queue drained by a Zephyr thread
+    #include <atomic>
+  #elif defined(HMS_STATUSLED_PLATFORM_HOST)
+    #define HMS_STATUSLED_HAS_COMMAND_QUEUE                                                               // Command queue drained by a std::thread
+    #include <mutex>
+    #include <atomic>
+    #include <thread>
+    #include <condition_variable>
+  #else
+    #error "HMS_STATUSLED_CONCURRENCY_ENABLED needs an RTOS (ESP32 FreeRTOS or Zephyr) or the host build"
+  #endif
+#endif
+
 typedef enum {
-  HMS_STATUSLED_TYPE_WS281XX = 0
+  HMS_STATUSLED_TYPE_WS281XX = 0,                                                                         // Timing from the HMS_STATUSLED_PULSE_* config macros
+  HMS_STATUSLED_TYPE_WS2811,                                                                              // 800kHz (high speed mode)
+  HMS_STATUSLED_TYPE_WS2811_400KHZ,                                                                       // 400kHz (low speed mode)
+  HMS_STATUSLED_TYPE_WS2812B,
+  HMS_STATUSLED_TYPE_WS2813,
+  HMS_STATUSLED_TYPE_SK6812,
+  HMS_STATUSLED_TYPE_TM1814,                                                                              // Inverted data line, idles high
+  HMS_STATUSLED_TYPE_CUSTOM                                                                               // Timing passed to the constructor
 } HMS_StatusLED_Type;
 
 typedef enum {
@@ -61,6 +120,164 @@ typedef enum {
   HMS_STATUSLED_ORDER_GRB = 2,
 } HMS_StatusLED_OrderType;
 
+typedef enum {
+  HMS_STATUSLED_SEGMENT_NORMAL   = 0x00,
+  HMS_STATUSLED_SEGMENT_REVERSED = 0x01,                                                                  // Segment pixel 0 is sent last
+  HMS_STATUSLED_SEGMENT_MIRRORED = 0x02,                                                                  // Second half repeats the first half backwards
+} HMS_StatusLED_SegmentFlags;
+
+typedef enum {
+  HMS_STATUSLED_BLEND_NORMAL = 0,                                                                         // Alpha over the layers below
+  HMS_STATUSLED_BLEND_ADD,                                                                                // Alpha scaled, saturating add
+} HMS_StatusLED_BlendMode;
+
+typedef enum {
+  HMS_STATUSLED_EFFECT_BREATHE = 0,                                                                       // color fades in and out of the background once per period
+  HMS_STATUSLED_EFFECT_BLINK,                                                                             // color for the first half of the period, background for the second
+  HMS_STATUSLED_EFFECT_CHASE,                                                                             // size pixels travel the range once per period, wrapping at the end
+  HMS_STATUSLED_EFFECT_SCANNER,                                                                           // Eye with a radius of size pixels sweeps back and forth (Larson scanner)
+  HMS_STATUSLED_EFFECT_RAINBOW,                                                                           // One hue wheel over the range, turning once per period (colors unused)
+  HMS_STATUSLED_EFFECT_SPARKLE,                                                                           // size / 256 of the pixels flash each period and fade out
+  HMS_STATUSLED_EFFECT_FIRE,                                                                              // Flames rising from the range start, size = cooling, period = flicker (colors unused)
+  HMS_STATUSLED_EFFECT_COMET,                                                                             // Head travels the range once per period with a tail of size pixels
+  HMS_STATUSLED_EFFECT_PROGRESS                                                                           // size / 255 of the range filled, the last pixel partially (period unused)
+} HMS_StatusLED_EffectType;
+
+typedef struct {
+  uint16_t                            bitNs;                                                            // Length of one bit (T0H + T0L)
+  uint16_t                            t0hNs;                                                            // High time of a 0 bit
+  uint16_t                            t1hNs;                                                            // High time of a 1 bit
+  uint16_t                            resetUs;                                                          // Low time that latches the frame
+  bool                                inverted;                                                         // Data line is active low (idles high)
+} HMS_StatusLED_Timing;
+
+typedef struct {
+  uint16_t                start;
+  uint16_t                length;
+  HMS_StatusLED_OrderType colorOrder;                                                                     // Wire order of the LEDs in this segment
+  uint8_t                 brightness;                                                                     // Segment brightness, relative to the strip brightness
+  bool                    isOn;
+  uint8_t                 flags;                                                                          // HMS_StatusLED_SegmentFlags
+} HMS_StatusLED_Segment;
+
+typedef struct {
+  std::vector<uint32_t>   pixels;                                                                         // Packed 0xAARRGGBB per pixel, before gamma
+  uint8_t                 opacity;                                                                        // Multiplied with every pixel alpha
+  HMS_StatusLED_BlendMode blendMode;
+} HMS_StatusLED_Layer;
+
+typedef struct {
+  HMS_StatusLED_EffectType type;
+  uint32_t                color;                                                                          // RGB888
+  uint32_t                background;                                                                     // RGB888 of the unlit pixels
+  uint16_t                periodMs;                                                                       // Length of one cycle
+  uint8_t                 size;                                                                           // Meaning depends on the type
+} HMS_StatusLED_Effect;
+
+#define HMS_STATUSLED_RGBA(R, G, B, A)    ((((uint32_t)(A)) << 24) | HMS_STATUSLED_RGB_TO_888(R, G, B))
+
+#define HMS_STATUSLED_ANIMATION_LOOP      0x01                                                            // Container flag: restart after the last frame
+
+#if defined(HMS_STATUSLED_PLATFORM_ARDUINO) || defined(HMS_STATUSLED_PLATFORM_ESP_IDF) || \
+    defined(HMS_STATUSLED_PLATFORM_ZEPHYR) || defined(HMS_STATUSLED_PLATFORM_STM32_HAL) || defined(HMS_STATUSLED_PLATFORM_HOST)
+  #define HMS_STATUSLED_HAS_ENCODER                                                                       // Platform encodes pixels into a slot buffer (RMT items / DMA compare values / wire bytes)
+#endif
+
+#if defined(HMS_STATUSLED_ESP_RMT_LEGACY)
+  typedef rmt_item32_t HMS_StatusLED_EncodedSlot;                                                         // One encoded bit as an RMT item
+  #define HMS_STATUSLED_SLOTS_PER_CHANNEL 8
+#elif defined(HMS_STATUSLED_PLATFORM_ARDUINO_ESP32) || defined(HMS_STATUSLED_PLATFORM_ESP_IDF)
+  typedef uint8_t      HMS_StatusLED_EncodedSlot;                                                         // One color channel as a byte, expanded by the RMT bytes encoder
+  #define HMS_STATUSLED_SLOTS_PER_CHANNEL 1
+#elif defined(HMS_STATUSLED_PLATFORM_ARDUINO)
+  typedef uint8_t      HMS_StatusLED_EncodedSlot;                                                         // One color channel as the final wire byte (bit-bang / PIO)
+  #define HMS_STATUSLED_SLOTS_PER_CHANNEL 1
+#elif defined(HMS_STATUSLED_PLATFORM_ZEPHYR)
+  typedef uint8_t      HMS_StatusLED_EncodedSlot;                                                         // One encoded bit as an SPI byte (8 SPI bits per LED bit)
+  #define HMS_STATUSLED_SLOTS_PER_CHANNEL 8
+#elif defined(HMS_STATUSLED_PLATFORM_STM32_HAL) || defined(HMS_STATUSLED_PLATFORM_HOST)
+  typedef uint8_t      HMS_StatusLED_EncodedSlot;                                                         // One encoded bit as a timer compare value
+  #define HMS_STATUSLED_SLOTS_PER_CHANNEL 8
+#endif
+
+#define HMS_STATUSLED_SLOTS_PER_PIXEL   (3 * HMS_STATUSLED_SLOTS_PER_CHANNEL)
+
+#if defined(HMS_STATUSLED_HAS_COMMAND_QUEUE)
+  typedef enum {
+    HMS_STATUSLED_COMMAND_PIXEL = 0,                                                                      // index, value = color
+    HMS_STATUSLED_COMMAND_FILL,                                                                           // index = start, count, value = color
+    HMS_STATUSLED_COMMAND_BRIGHTNESS,                                                                     // value = brightness
+    HMS_STATUSLED_COMMAND_POWER,                                                                          // value = 1 turns on, 0 turns off
+    HMS_STATUSLED_COMMAND_POWER_BUDGET,                                                                   // value = budget in mA
+    HMS_STATUSLED_COMMAND_SHOW
+  } HMS_StatusLED_CommandType;
+
+  typedef struct {
+    uint8_t                             type;                                                             // HMS_StatusLED_CommandType
+    uint16_t                            index;
+    uint16_t                            count;
+    uint32_t                            value;
+  } HMS_StatusLED_Command;
+
+  class HMS_StatusLED_CommandQueue {                                                                      // Bounded lock-free ring, any task or ISR pushes, the LED task pops
+    public:
+      HMS_StatusLED_CommandQueue();
+
+      bool push(const HMS_StatusLED_Command &command);                                                    // Never blocks, false when the ring is full
+      bool pop(HMS_StatusLED_Command &command);                                                           // Consumer side, LED task only
+
+    private:
+      static_assert((HMS_STATUSLED_COMMAND_QUEUE_SIZE & (HMS_STATUSLED_COMMAND_QUEUE_SIZE - 1)) == 0,
+                    "HMS_STATUSLED_COMMAND_QUEUE_SIZE must be a power of two");
+
+      struct Cell {
+        std::atomic<uint32_t>           sequence;                                                         // Publishes the cell: position + 1 when written, position + size when free
+        HMS_StatusLED_Command           command;
+      };
+
+      Cell                              cells[HMS_STATUSLED_COMMAND_QUEUE_SIZE];
+      std::atomic<uint32_t>             enqueuePosition;
+      uint32_t                          dequeuePosition;
+  };
+#endif
+
+typedef enum {
+  HMS_STATUSLED_TRACE_SHOW = 1,                                                                           // arg0 = channels patched by refresh(), arg1 = encoded slots sent
+  HMS_STATUSLED_TRACE_PIXEL,                                                                              // arg0 = pixel index, arg1 = color as passed in
+  HMS_STATUSLED_TRACE_FILL,                                                                               // arg0 = pixel count, arg1 = color
+  HMS_STATUSLED_TRACE_BRIGHTNESS,                                                                         // arg0 = brightness, arg1 = 16-bit brightness
+  HMS_STATUSLED_TRACE_POWER                                                                               // arg0 = 1 on, 0 off
+} HMS_StatusLED_TraceEvent;
+
+typedef struct {                                                                                          // 12 bytes, little endian on every supported target
+  uint32_t                              timestamp;                                                        // Microseconds, wraps after ~71 minutes (STM32 with DWT: with the cycle counter)
+  uint8_t                               event;                                                            // HMS_StatusLED_TraceEvent
+  uint8_t                               reserved;
+  uint16_t                              arg0;
+  uint32_t                              arg1;
+} HMS_StatusLED_TraceRecord;
+
+class HMS_StatusLED;
+
+class HMS_StatusLED_SegmentView {                                                                         // Lightweight handle to one segment of a strip
+  public:
+    HMS_StatusLED_SegmentView(HMS_StatusLED *driver, uint8_t segmentId);
+
+    void turnOn();
+    void turnOff();
+    void setBrightness(uint8_t brightness);
+
+    bool isValid() const;
+    uint16_t length() const;
+
+    HMS_StatusLED_StatusTypeDef fill(uint32_t color);
+    HMS_StatusLED_StatusTypeDef setPixelColor(uint32_t color, uint16_t pixelIndex);                      // pixelIndex is relative to the segment start
+
+  private:
+    HMS_StatusLED                       *driver;
+    uint8_t                             segmentId;
+};
+
 class HMS_StatusLED {
   public:
     HMS_StatusLED(
@@ -68,62 +285,367 @@ class HMS_StatusLED {
       HMS_StatusLED_Type type = HMS_STATUSLED_TYPE_WS281XX, 
       HMS_StatusLED_OrderType colorOrder = HMS_STATUSLED_DEFAULT_COLOR_ORDER
     );
+    HMS_StatusLED(
+      uint16_t maxPixels,
+      const HMS_StatusLED_Timing &timing,
+      HMS_StatusLED_OrderType colorOrder = HMS_STATUSLED_DEFAULT_COLOR_ORDER
+    );
     ~HMS_StatusLED();
 
     #if defined(HMS_STATUSLED_PLATFORM_ARDUINO) && !defined(HMS_STATUSLED_PLATFORM_ARDUINO_ESP32)
       HMS_StatusLED_StatusTypeDef begin(uint8_t pin);
-    #elif defined(HMS_STATUSLED_PLATFORM_ARDUINO_ESP32) || defined(HMS_STATUSLED_PLATFORM_ESP_IDF)
+    #elif defined(HMS_STATUSLED_ESP_RMT_LEGACY)
       HMS_StatusLED_StatusTypeDef begin(uint8_t pin, rmt_channel_t channel = RMT_CHANNEL_0);      
+    #elif defined(HMS_STATUSLED_PLATFORM_ARDUINO_ESP32) || defined(HMS_STATUSLED_PLATFORM_ESP_IDF)
+      HMS_StatusLED_StatusTypeDef begin(uint8_t pin);                                                                             // RMT channel is allocated by the driver
     #elif defined(HMS_STATUSLED_PLATFORM_ZEPHYR)
+      HMS_StatusLED_StatusTypeDef begin(const struct device *spi);
     #elif defined(HMS_STATUSLED_PLATFORM_STM32_HAL)
       HMS_StatusLED_StatusTypeDef begin(TIM_HandleTypeDef *hTim, uint16_t timerBusFrequencyMHz, uint8_t channel);
+    #elif defined(HMS_STATUSLED_PLATFORM_HOST)
+      HMS_StatusLED_StatusTypeDef begin(uint16_t timerFrequencyMHz = 80);                                                          // Simulated PWM timer, one period per bit
     #endif
 
     void clear();
     void turnOn();
     void turnOff();
     void setBrightness(uint8_t brightness);
+    void setBrightness16(uint16_t brightness);                                                                                    // 0-65535, fractions of an 8-bit level are dithered in HDR mode
     void setColorOrder(HMS_StatusLED_OrderType order);
+    void setPowerBudget(uint32_t maxMilliAmps, uint8_t milliAmpsPerChannel = HMS_STATUSLED_DEFAULT_MA_PER_CHANNEL);
+
+    uint32_t getEstimatedCurrent() const;                                                                                         // Estimated strip current in mA (after power limiting)
+    const HMS_StatusLED_Timing& getTiming() const                                                   { return timing;            }
+    uint16_t getPixelCount() const                                                                  { return maxPixel;          }
+    uint16_t getBrightness16() const                                                                { return brightness16;      }
+
+    static const HMS_StatusLED_Timing& getTimingProfile(HMS_StatusLED_Type type);                                                 // Built-in profile of a chip family
+    static uint32_t getSPIPatterns(const HMS_StatusLED_Timing &timing, uint8_t &pulse0, uint8_t &pulse1);                        // SPI clock (Hz) and 0/1 byte patterns of the Zephyr backend
+
+    static uint16_t readTrace(HMS_StatusLED_TraceRecord *records, uint16_t maxRecords);                                            // Oldest first, consumed records are not returned again
+    static void dumpTrace();                                                                                                      // Format and print the unread records
+    static const char* getTraceEventName(uint8_t event);
+
+    void clearSegments();
+    HMS_StatusLED_SegmentView segment(uint8_t segmentId);
+
+    HMS_StatusLED_StatusTypeDef setLayerCount(uint8_t count);                                                                     // Allocate transparent layers, 0 frees them
+    HMS_StatusLED_StatusTypeDef setLayerPixel(uint8_t layer, uint16_t pixelIndex, uint32_t color, uint8_t alpha = 255);           // color is RGB888
+    HMS_StatusLED_StatusTypeDef fillLayer(uint8_t layer, uint32_t color, uint8_t alpha = 255, uint16_t startIndex = 0, uint16_t count = 0);
+    HMS_StatusLED_StatusTypeDef setLayerOpacity(uint8_t layer, uint8_t opacity);
+    HMS_StatusLED_StatusTypeDef setLayerBlendMode(uint8_t layer, HMS_StatusLED_BlendMode mode);
+    HMS_StatusLED_StatusTypeDef composite();                                                                                      // Blend the dirty range of all layers into the pixels
+    HMS_StatusLED_StatusTypeDef crossfade(const uint32_t *fromFrame, const uint32_t *toFrame, uint8_t t, uint16_t startIndex = 0, uint16_t count = 0);   // RGB888 frames, t = 0 from .. 255 to
+
+    HMS_StatusLED_StatusTypeDef renderEffect(const HMS_StatusLED_Effect &effect, uint32_t nowMs, uint16_t startIndex = 0, uint16_t count = 0);  // One frame of the effect into the pixels, show() sends it
+    static void renderEffectFrame(const HMS_StatusLED_Effect &effect, uint32_t nowMs, uint32_t *frame, uint16_t count);           // Same kernels into a packed RGB888 buffer (layers, crossfade, host tools)
+
+    HMS_StatusLED_StatusTypeDef saveState(uint8_t stateId);                                                                       // Share the current pixels, brightness and power state, no pixel data is copied
+    HMS_StatusLED_StatusTypeDef restoreState(uint8_t stateId);                                                                    // Rewrite the pixels changed since, the state stays saved
+    void releaseState(uint8_t stateId);
+    HMS_StatusLED_StatusTypeDef pushState();                                                                                      // saveState() into the highest free id
+    HMS_StatusLED_StatusTypeDef popState();                                                                                       // Restore and release the last pushed state
+    uint16_t getStateBlockCount() const;                                                                                          // Blocks preserved for saved states (RAM in use)
+
+    HMS_StatusLED_StatusTypeDef playAnimation(const uint8_t *data, uint32_t size);                                                 // Container in flash / mmap, read in place and never copied
+    HMS_StatusLED_StatusTypeDef updateAnimation(uint32_t nowMs);                                                                  // Decode and show the next frame once the current one is due
+    void stopAnimation()                                                                            { animationPlaying = false; }
+    bool isAnimationPlaying() const                                                                 { return animationPlaying;  }
+
+    static void createAnimation(std::vector<uint8_t> &container, uint16_t pixelCount, uint8_t flags = 0);                         // Start a container (host tools, build time)
+    static HMS_StatusLED_StatusTypeDef appendAnimationFrame(std::vector<uint8_t> &container, const uint32_t *frame,
+                                                            const uint32_t *previous, uint16_t durationMs);                       // RGB888 frame, delta against previous (nullptr: keyframe)
+
+    #if defined(HMS_STATUSLED_HAS_ENCODER)
+      void releaseCachedFrame(uint8_t frameId);
+      HMS_StatusLED_StatusTypeDef cacheFrame(uint8_t frameId);                                                                    // Pre-encode the current pixels into a cache slot
+      HMS_StatusLED_StatusTypeDef cacheColor(uint8_t frameId, uint32_t color);                                                    // Pre-encode a solid color frame, pixels are not touched
+      HMS_StatusLED_StatusTypeDef showCached(uint8_t frameId);                                                                    // Transmit a cached frame without any encode work
+
+      HMS_StatusLED_StatusTypeDef setPaletteMode(uint8_t bitsPerPixel);                                                           // 4 or 8 enables indexed mode, 0 returns to direct color mode
+      HMS_StatusLED_StatusTypeDef setPaletteColor(uint8_t entry, uint32_t color);
+      HMS_StatusLED_StatusTypeDef setPixelIndex(uint8_t entry, uint16_t pixelIndex);
+      HMS_StatusLED_StatusTypeDef fillIndex(uint8_t entry, uint16_t startIndex = 0, uint16_t count = 0);                          // count = 0 fills up to the end of the strip
+
+      HMS_StatusLED_StatusTypeDef setHDRMode(bool enabled);                                                                       // Encode with the 16-bit brightness, sub-level fractions dithered over frames
+      HMS_StatusLED_StatusTypeDef refresh();                                                                                      // Next dither frame, only the dithered channels are re-encoded
+      bool isHDRMode() const                                                                        { return hdrMode;           }
+
+      void setRingOffset(uint16_t offset);                                                                                        // Strip position 0 shows pixel offset, nothing is moved
+      uint16_t getRingOffset() const                                                                { return ringOffset;        }
+
+      void setTableEncodeMode(bool enabled);                                                                                      // Encode through one 256 entry table of final slots, brightness changes cost O(256)
+      bool isTableEncodeMode() const                                                                { return !byteTable.empty(); }
+    #endif
+
+    #if defined(HMS_STATUSLED_HAS_COMMAND_QUEUE)
+      #if defined(HMS_STATUSLED_PLATFORM_ZEPHYR)
+        HMS_StatusLED_StatusTypeDef startTask(k_thread_stack_t *stack, size_t stackSize, int priority = HMS_STATUSLED_TASK_PRIORITY);
+      #elif defined(HMS_STATUSLED_PLATFORM_HOST)
+        HMS_StatusLED_StatusTypeDef startTask();
+      #else
+        HMS_StatusLED_StatusTypeDef startTask(UBaseType_t priority = HMS_STATUSLED_TASK_PRIORITY, BaseType_t core = tskNO_AFFINITY);
+      #endif
+      void stopTask();
+      void processCommands();                                                                                                     // Apply all queued commands, called by the LED task
+
+      HMS_StatusLED_StatusTypeDef post(const HMS_StatusLED_Command &command);                                                     // Queue a command from any task, never blocks
+      HMS_StatusLED_StatusTypeDef postPixelColor(uint32_t color, uint16_t pixelIndex);
+      HMS_StatusLED_StatusTypeDef postFill(uint32_t color, uint16_t startIndex = 0, uint16_t count = 0);
+      HMS_StatusLED_StatusTypeDef postBrightness(uint8_t brightness);
+      HMS_StatusLED_StatusTypeDef postPower(bool on);
+      HMS_StatusLED_StatusTypeDef postPowerBudget(uint32_t maxMilliAmps);
+      HMS_StatusLED_StatusTypeDef postShow();
+      HMS_StatusLED_StatusTypeDef setPixelColorFromISR(uint32_t color, uint16_t pixelIndex);                                      // Queue a pixel write from an interrupt handler
+
+      void setMaxFps(uint16_t fps);                                                                                               // Frame rate cap of the LED task (0 = no cap)
+
+      uint32_t getDroppedCommands() const                                                           { return droppedCommands.load(std::memory_order_relaxed); }
+      uint32_t getCoalescedFrames() const                                                           { return coalescedFrames.load(std::memory_order_relaxed); }
+    #endif
+
+    #if defined(HMS_STATUSLED_PLATFORM_HOST)
+      const std::vector<HMS_StatusLED_EncodedSlot>& getCapturedFrame() const                        { return capturedFrame;     }  // Compare values of the last transmitted frame
+      uint16_t getTimerFrequency() const                                                            { return timerFrequencyMHz; }
+      uint32_t getTimerPeriod() const                                                               { return autoReloadValue + 1; }  // Timer ticks per bit
+      uint64_t getSimulatedTimeNs() const                                                           { return simulatedTimeNs;   }  // Wire + latch time of all frames sent so far
+    #endif
 
     HMS_StatusLED_StatusTypeDef show();
+    HMS_StatusLED_StatusTypeDef addSegment(
+      uint16_t start, uint16_t length,
+      HMS_StatusLED_OrderType order = HMS_STATUSLED_DEFAULT_COLOR_ORDER,
+      uint8_t flags = HMS_STATUSLED_SEGMENT_NORMAL,
+      uint8_t *segmentId = nullptr
+    );
+    HMS_StatusLED_StatusTypeDef fill(uint32_t color, uint16_t startIndex = 0, uint16_t count = 0);                               // count = 0 fills up to the end of the strip
     HMS_StatusLED_StatusTypeDef setPixelColor(uint32_t color, uint16_t pixelIndex);
     HMS_StatusLED_StatusTypeDef setPixelColor(uint32_t color, uint16_t pixelIndex, HMS_StatusLED_OrderType colorOrder);
 
+    HMS_StatusLED_StatusTypeDef shift(int16_t distance, uint16_t startIndex = 0, uint16_t count = 0);                            // Positive moves towards the strip end, vacated pixels are cleared
+    HMS_StatusLED_StatusTypeDef rotate(int16_t distance, uint16_t startIndex = 0, uint16_t count = 0);                           // Like shift(), pixels moved out come back in on the other side
+    HMS_StatusLED_StatusTypeDef mirror(uint16_t startIndex = 0, uint16_t count = 0);                                             // Reverse the pixel order of the range
+
+    HMS_StatusLED_StatusTypeDef setPixelRGB(uint8_t r, uint8_t g, uint8_t b, uint16_t pixelIndex);                               // Typed setters skip format detection
+    HMS_StatusLED_StatusTypeDef setPixelColor565(uint16_t color, uint16_t pixelIndex);
+    HMS_StatusLED_StatusTypeDef setPixelColor888(uint32_t color, uint16_t pixelIndex);
+    HMS_StatusLED_StatusTypeDef setPixels565(const uint16_t *colors, uint16_t count, uint16_t startIndex = 0);                  // count pixels from startIndex, clipped at the strip end
+    HMS_StatusLED_StatusTypeDef setPixels888(const uint32_t *colors, uint16_t count, uint16_t startIndex = 0);
+    HMS_StatusLED_StatusTypeDef setPixelsRGB(const uint8_t *rgb, uint16_t count, uint16_t startIndex = 0);                      // Packed R, G, B bytes per pixel
+
+    HMS_StatusLED_StatusTypeDef setPixelHSV(uint8_t hue, uint8_t saturation, uint8_t value, uint16_t pixelIndex);                // Hue 0-255 covers the full wheel
+    HMS_StatusLED_StatusTypeDef fillRainbow(uint16_t startIndex = 0, uint16_t count = 0, uint8_t hueStart = 0, uint8_t hueDelta = 0);   // hueDelta = 0 spreads one wheel over the range
+    HMS_StatusLED_StatusTypeDef fillGradient(uint32_t startColor, uint32_t endColor, uint16_t startIndex = 0, uint16_t count = 0);
+
+    static uint32_t colorHSV(uint8_t hue, uint8_t saturation = 255, uint8_t value = 255);                                        // RGB888 of an HSV color (integer only)
+
   private:
-    #if defined(HMS_STATUSLED_PLATFORM_ARDUINO)
-      #if defined(HMS_STATUSLED_PLATFORM_ARDUINO_ESP32) || defined(HMS_STATUSLED_PLATFORM_ESP_IDF)
+    friend class HMS_StatusLED_SegmentView;
+
+    #if defined(HMS_STATUSLED_PLATFORM_ARDUINO_ESP32) || defined(HMS_STATUSLED_PLATFORM_ESP_IDF)
+      uint8_t                           outputPin;
+      #if defined(HMS_STATUSLED_ESP_RMT_LEGACY)
         rmt_channel_t                   rmtChannel;
-        uint8_t                         outputPin;
         rmt_item32_t*                   rmtItems;
+        rmt_item32_t                    bitItems[2];                                                    // Pre-computed RMT items of a 0 and a 1 bit
+        int64_t                         lastFrameEnd         = 0;                                       // esp_timer_get_time() when the last frame leaves the wire (predicted)
       #else
-        uint8_t                         outputPin;
+        rmt_channel_handle_t            rmtChannel           = nullptr;
+        rmt_encoder_handle_t            bytesEncoder         = nullptr;
+        SemaphoreHandle_t               transferDone         = nullptr;                                 // Given by onTransferDone() when the channel is idle
+        volatile int64_t                lastFrameEnd         = 0;                                       // esp_timer_get_time() when the last frame left the wire
+      #endif
+    #elif defined(HMS_STATUSLED_PLATFORM_ARDUINO)
+      uint8_t                           outputPin;
+      uint32_t                          frameStart           = 0;                                       // micros() when the last frame was started
+      uint32_t                          frameHold            = 0;                                       // Wire time + latch time of that frame in µs
+      #if defined(HMS_STATUSLED_PLATFORM_ARDUINO_SAMD)
+        volatile uint32_t               *outputPort          = nullptr;
+        uint32_t                        outputMask           = 0;
+        uint16_t                        t0hCycles            = 0;                                       // Pre-computed SysTick cycles of the timing profile
+        uint16_t                        t1hCycles            = 0;
+        uint16_t                        bitCycles            = 0;
+      #elif defined(HMS_STATUSLED_PLATFORM_ARDUINO_RP2040)
+        PIO                             pio                  = nullptr;
+        int                             stateMachine         = -1;
+        int                             dmaChannel           = -1;
+        uint8_t                         programOffset        = 0;                                       // Where pio_add_program() put the WS2812 program
       #endif
     #elif defined(HMS_STATUSLED_PLATFORM_ZEPHYR)
+      const struct device               *spiDevice           = nullptr;
+      struct spi_config                 spiConfig            = {};
+      struct k_sem                      transferDone;                                                   // Given when the SPI bus is idle
+      uint32_t                          frameStart           = 0;                                       // k_cycle_get_32() when the last frame was queued
+      uint32_t                          frameHold            = 0;                                       // Wire time + latch time of that frame in cycles
+      uint8_t                           pulse0               = 0;                                       // SPI byte pattern of a 0 bit (T0H)
+      uint8_t                           pulse1               = 0;                                       // SPI byte pattern of a 1 bit (T1H)
     #elif defined(HMS_STATUSLED_PLATFORM_STM32_HAL)
       uint8_t                           timerChannel         = 0;
       uint16_t                          pulse0               = 0;
       uint16_t                          pulse1               = 0;
       uint32_t                          autoReloadValue      = 0;
+      uint32_t                          frameStart           = 0;                                       // Latch clock value when the last DMA transfer was started
+      uint32_t                          frameHold            = 0;                                       // Wire time + latch time of that frame in latch clock ticks
       static TIM_HandleTypeDef          *statusLED_hTim;
+    #elif defined(HMS_STATUSLED_PLATFORM_HOST)
+      uint8_t                           pulse0               = 0;
+      uint8_t                           pulse1               = 0;
+      uint32_t                          autoReloadValue      = 0;
+      uint16_t                          timerFrequencyMHz    = 0;                                       // 0 until begin()
+      uint64_t                          simulatedTimeNs      = 0;
+      std::vector<uint8_t>              capturedFrame;                                                  // What the DMA would have fed to the timer
     #endif
 
     uint16_t                            maxPixel;
     HMS_StatusLED_Type                  ledType;
     HMS_StatusLED_OrderType             colorOrder;
+    HMS_StatusLED_Timing                timing;             // Bit timing, reset length and polarity of this strip
     std::vector<uint8_t>                buffer;
     std::vector<std::vector<uint8_t>>   pixel;              // Current display values (with brightness applied)
-    std::vector<std::vector<uint8_t>>   originalPixel;      // Original color values (before brightness)
-    std::vector<std::vector<uint8_t>>   lastState;          // Store last LED state for turnOn/turnOff
+    std::vector<std::vector<uint8_t>>   originalPixel;      // Original color values as R, G, B (before brightness and color order)
     uint8_t                             brightness;         // Global brightness (0-255)
-    bool                                isOn;               // Current on/off state
+    uint16_t                            brightness16;       // Global brightness (0-65535), brightness is its rounded up 8-bit value
+    bool                                isOn;               // Current on/off state, consulted at encode time
+    bool                                offFrameReady;      // Encoded buffer already holds the all-zero frame
+    uint32_t                            channelSum;         // Running sum of all originalPixel channels (power estimation)
+    uint32_t                            powerBudget;        // Maximum strip current in mA (0 = unlimited)
+    uint8_t                             milliAmpsPerChannel;// Current of one channel at full duty in mA
+    std::vector<HMS_StatusLED_Segment>  segments;           // Segment table, indexed by segment id
+    std::vector<uint8_t>                segmentOrder;       // Segment ids sorted by start pixel (encode order)
+    uint8_t                             paletteBits;        // Bits per pixel in indexed mode (0 = direct color mode)
+    std::vector<HMS_StatusLED_Layer>    layers;             // Compositing layers, bottom first
+    uint16_t                            dirtyStart;         // First pixel to recomposite
+    uint16_t                            dirtyEnd;           // One past the last pixel to recomposite (dirtyStart == dirtyEnd: clean)
+    const uint8_t                       *animationData       = nullptr;                                  // Animation container, read in place
+    uint32_t                            animationSize        = 0;
+    uint32_t                            animationOffset      = 0;                                        // Header of the next frame
+    uint16_t                            animationFrame       = 0;                                        // Index of the next frame
+    uint16_t                            animationDuration    = 0;                                        // Display time of the frame on the strip in ms
+    uint32_t                            animationFrameStart  = 0;                                        // nowMs when that frame was shown
+    bool                                animationPlaying     = false;
+    uint16_t                            encodeStart          = 0;                                        // First pixel written since the last encode
+    uint16_t                            encodeEnd            = 0;                                        // One past the last one (encodeStart == encodeEnd: none)
+    bool                                encodeAll            = true;                                     // Next encode must cover every pixel
+    uint16_t                            encodedPowerScale    = 256;                                      // Power scale of the live buffer
+
+    struct SavedState {
+      std::vector<uint16_t>             blocks;                                                           // Pool block per strip block, HMS_STATUSLED_STATE_SHARED while the live block is unchanged
+      uint16_t                          brightness16         = 65535;
+      bool                              isOn                 = true;
+      bool                              used                 = false;
+    };
+
+    SavedState                          states[HMS_STATUSLED_MAX_STATES];
+    std::vector<uint8_t>                statePool;                                                        // Preserved blocks, HMS_STATUSLED_STATE_BLOCK_PIXELS stored pixels each
+    std::vector<uint8_t>                statePoolRefs;                                                    // Saved states using each pool block (0 = free)
+    std::vector<uint32_t>               blockEpoch;                                                       // stateEpoch when each strip block was last preserved
+    uint32_t                            stateEpoch           = 0;                                        // Advanced by every save and restore
+    uint8_t                             stateCount           = 0;
+    uint8_t                             stateStack[HMS_STATUSLED_MAX_STATES];                             // Ids taken by pushState(), last on top
+    uint8_t                             stateDepth           = 0;
 
     #if defined(HMS_STATUSLED_PLATFORM_ARDUINO_ESP32) || defined(HMS_STATUSLED_PLATFORM_ESP_IDF)
       void updateRMTBuffer();                                                                                                     // Convert pixel data to RMT format
+      #if !defined(HMS_STATUSLED_ESP_RMT_LEGACY)
+        static bool onTransferDone(rmt_channel_handle_t channel, const rmt_tx_done_event_data_t *event, void *userData);
+      #endif
+    #elif defined(HMS_STATUSLED_PLATFORM_ARDUINO)
+      void updateWireBuffer();                                                                                                    // Convert pixel data to final wire bytes
+      #if defined(HMS_STATUSLED_PLATFORM_ARDUINO_RP2040)
+        void releasePIO();                                                                                                        // Free the DMA channel, state machine and program, the pin goes back to GPIO
+      #endif
+    #elif defined(HMS_STATUSLED_PLATFORM_ZEPHYR)
+      void updateSPIBuffer();                                                                                                     // Convert pixel data to SPI byte patterns
+      static void onTransferDone(const struct device *dev, int result, void *userData);
     #elif defined(HMS_STATUSLED_PLATFORM_STM32_HAL)
       void updateDMABuffer();                                                                                                     // Convert pixel data to DMA buffer format
+    #elif defined(HMS_STATUSLED_PLATFORM_HOST)
+      void updateDMABuffer();                                                                                                     // Same compare value format as the STM32 HAL backend
+    #endif
+
+    #if defined(HMS_STATUSLED_HAS_ENCODER)
+      std::vector<HMS_StatusLED_EncodedSlot> frameCache[HMS_STATUSLED_MAX_CACHED_FRAMES];                                         // Pre-encoded frames for showCached()
+      std::vector<uint8_t>                   paletteIndex;                                                                        // Packed palette index per pixel (indexed mode)
+      std::vector<uint32_t>                  paletteColor;                                                                        // Gamma corrected RGB888 per palette entry
+      std::vector<uint16_t>                  paletteUseCount;                                                                     // Pixels referencing each entry (power estimation)
+      std::vector<HMS_StatusLED_EncodedSlot> paletteEncoded;                                                                      // HMS_STATUSLED_SLOTS_PER_PIXEL pre-encoded slots per entry (order, brightness, power applied)
+      uint16_t                               paletteScale     = 256;                                                              // Power scale paletteEncoded was built with
+      bool                                   paletteDirty     = false;                                                            // paletteEncoded must be rebuilt before the next encode
+
+      struct DitherChannel {
+        uint32_t                             slot;                                                                                // First slot of the channel in the live buffer
+        uint8_t                              level;                                                                               // Integer part of the scaled channel
+        uint8_t                              fraction;                                                                            // Frames out of 256 that send level + 1
+        uint8_t                              offset;                                                                              // Dither phase of the pixel
+      };
+
+      std::vector<DitherChannel>             ditherChannels;                                                                      // Channels of the live buffer that change between dither frames
+      uint8_t                                ditherFrame      = 0;
+      bool                                   hdrMode          = false;
+
+      std::vector<HMS_StatusLED_EncodedSlot> byteTable;                                                                           // HMS_STATUSLED_SLOTS_PER_CHANNEL final slots per stored channel value, empty unless in table mode
+      uint32_t                               byteTableKey     = UINT32_MAX;                                                       // brightness << 16 | power scale the table was built with
+      uint16_t                               ringOffset       = 0;                                                                // Pixel the encoder starts at, wraps around the strip end
+
+      HMS_StatusLED_EncodedSlot* encodedData();                                                                                   // Live encoded buffer
+      uint32_t encodedLength() const;                                                                                             // Live encoded buffer length in slots, including the reset
+      HMS_StatusLED_StatusTypeDef transmit(const HMS_StatusLED_EncodedSlot *data, uint32_t length);                               // Hand an encoded frame to the peripheral
+      void waitForTransfer();                                                                                                     // Block until the previous frame and its latch time are over
+      void encodeFrame(uint32_t &index);                                                                                          // Encode all pixels, applying segments and the power limit
+      void encodeByte(uint8_t colorValue, HMS_StatusLED_EncodedSlot *slots);                                                      // Platform specific bit expansion of one channel into 8 slots
+      void encodeRange(uint16_t start, uint16_t length, uint16_t scale, const uint8_t channelMap[3], uint8_t flags, uint32_t &index);
+      void updateByteTable(uint16_t scale);                                                                                       // Rebuild byteTable if brightness or the power scale changed
+      void encodeDithered(uint16_t level, uint16_t pixelIndex, HMS_StatusLED_EncodedSlot *slots);                                 // level is 8.8 fixed point, registers the channel if it has a fraction
+      void encodeIndexedFrame(uint32_t &index);                                                                                   // Gather pre-encoded palette entries, no per pixel math
+      void encodePaletteEntry(uint8_t entry);
+      void writePixelIndex(uint8_t entry, uint16_t pixelIndex);
+      uint8_t getPixelIndex(uint16_t pixelIndex) const;
+      uint16_t getPaletteEntrySum(uint8_t entry) const;
     #endif
-    
+
+    #if defined(HMS_STATUSLED_HAS_COMMAND_QUEUE)
+      HMS_StatusLED_CommandQueue             commandQueue;
+      std::atomic<uint32_t>                  droppedCommands  {0};                                                                // Commands lost because the queue was full
+      std::atomic<uint32_t>                  coalescedFrames  {0};                                                                // Show requests merged into another frame
+      std::atomic<uint32_t>                  frameInterval    {0};                                                                // Minimum time between two frames in µs
+      uint32_t                               pendingShows     = 0;                                                                // Show requests since the last rendered frame
+      int64_t                                lastRenderTime   = INT64_MIN / 2;                                                    // Render clock (µs) of the last rendered frame, the first frame is never held back
+      #if defined(HMS_STATUSLED_PLATFORM_ZEPHYR)
+        struct k_thread                      ledThread;
+        k_tid_t                              ledTask          = nullptr;
+        struct k_sem                         commandReady;                                                                        // Given by producers, taken by the LED task
+      #elif defined(HMS_STATUSLED_PLATFORM_HOST)
+        std::thread                          ledTask;
+        std::mutex                           taskMutex;                                                                           // Guards commandPending and stopRequested
+        std::condition_variable              commandReady;                                                                        // Notified by producers and stopTask()
+        bool                                 commandPending   = false;
+        bool                                 stopRequested    = false;
+      #else
+        TaskHandle_t                         ledTask          = nullptr;                                                          // Notified by producers
+      #endif
+
+      HMS_StatusLED_StatusTypeDef enqueue(const HMS_StatusLED_Command &command, bool fromISR);
+      int64_t getFrameDelay() const;                                                                                              // µs until the pending frame may be rendered, -1 when none is pending
+      #if defined(HMS_STATUSLED_PLATFORM_ZEPHYR)
+        static void ledTaskEntry(void *instance, void *unused1, void *unused2);
+      #else
+        static void ledTaskEntry(void *instance);
+      #endif
+    #endif
+
     void applyBrightnessToAllPixels();                                                                                            // Apply current brightness to all pixels
+    void decodeColor(uint32_t color, uint8_t &r, uint8_t &g, uint8_t &b) const;                                                   // RGB565 tag check and gamma correction
+    void unpackColor(uint32_t color, uint8_t &r, uint8_t &g, uint8_t &b) const;                                                   // RGB565 tag check and expansion only
+    void storeRGB(uint16_t pixelIndex, uint8_t r, uint8_t g, uint8_t b, HMS_StatusLED_OrderType order);                           // Store gamma corrected RGB in the given order
+    void storePacked(uint16_t pixelIndex, uint32_t color);                                                                        // Gamma correct and store a packed RGB888 word
+    void markDirty(uint16_t start, uint16_t end);
+    void markEncodeDirty(uint16_t start, uint16_t end);                                                                           // Pixels the next encode has to cover
+    void preserveBlock(uint16_t block);                                                                                           // Copy a strip block out for the saved states still sharing it
+    HMS_StatusLED_StatusTypeDef prepareMove(uint16_t startIndex, uint16_t count, uint16_t &endIndex);                             // Range check, preserve saved states and mark the range for encode
+    HMS_StatusLED_StatusTypeDef decodeAnimationFrame();                                                                           // Apply the frame at animationOffset to the pixels
+    void storePixel(uint16_t pixelIndex, uint8_t c0, uint8_t c1, uint8_t c2);                                                     // Store R, G, B channels and keep channelSum in sync
+    void getChannelMap(HMS_StatusLED_OrderType order, uint8_t channelMap[3]) const;                                               // Stored (R, G, B) channel for each wire position of order
+    uint16_t calculatePowerScale(uint32_t sum) const;                                                                             // Output scale (0-256) that keeps a frame of this channel sum within powerBudget
 };
 
 #endif // HMS_STATUSLED_DRIVER_H
\ No newline at end of file
@@ -0,0 +1,48 @@
+#ifndef HMS_STATUSLED_MATRIX_H
+#define HMS_STATUSLED_MATRIX_H
+
+#include "HMS_StatusLED_DRIVER.h"
+
+#define HMS_STATUSLED_MATRIX_ROWS             0x00                                                        // Panel wired row by row (default)
+#define HMS_STATUSLED_MATRIX_SERPENTINE       0x01                                                        // Every second row (or column) of a panel runs backwards
+#define HMS_STATUSLED_MATRIX_COLUMNS          0x02                                                        // Panel wired column by column
+#define HMS_STATUSLED_MATRIX_TILE_SERPENTINE  0x04                                                        // Every second row of panels is chained right to left
+#define HMS_STATUSLED_MATRIX_NONE             0xFFFF                                                      // Remap entry of a position past the end of the strip
+
+typedef enum {
+  HMS_STATUSLED_MATRIX_ROTATE_0 = 0,
+  HMS_STATUSLED_MATRIX_ROTATE_90,                                                                         // Clockwise, the drawing's top left lands on the top right panel corner
+  HMS_STATUSLED_MATRIX_ROTATE_180,
+  HMS_STATUSLED_MATRIX_ROTATE_270,
+} HMS_StatusLED_MatrixRotation;
+
+class HMS_StatusLED_Matrix {                                                                              // 2D coordinates on top of one strip, mapped through a remap table
+  public:
+    HMS_StatusLED_Matrix(
+      HMS_StatusLED &driver,
+      uint16_t panelWidth,
+      uint16_t panelHeight,
+      uint8_t flags = HMS_STATUSLED_MATRIX_SERPENTINE,
+      uint8_t tilesX = 1,
+      uint8_t tilesY = 1,
+      HMS_StatusLED_MatrixRotation rotation = HMS_STATUSLED_MATRIX_ROTATE_0
+    );
+
+    uint16_t getWidth() const                                                                       { return width;             }  // After rotation
+    uint16_t getHeight() const                                                                      { return height;            }
+    uint16_t getIndex(uint16_t x, uint16_t y) const;                                                     // Strip index, HMS_STATUSLED_MATRIX_NONE when off the strip
+
+    HMS_StatusLED_StatusTypeDef setPixelXY(uint32_t color, uint16_t x, uint16_t y);
+    HMS_StatusLED_StatusTypeDef drawRect(uint32_t color, int16_t x, int16_t y, uint16_t w, uint16_t h, bool filled = true);   // Clipped to the matrix
+    HMS_StatusLED_StatusTypeDef blit(const uint8_t *rgb, int16_t x, int16_t y, uint16_t w, uint16_t h, uint16_t stride = 0);   // Packed R, G, B bitmap, stride in pixels (0 = w), clipped
+
+  private:
+    HMS_StatusLED                       &driver;
+    uint16_t                            width;
+    uint16_t                            height;
+    std::vector<uint16_t>               remap;                                                            // Strip index per position, row major over the rotated matrix
+
+    void fillRow(uint32_t color, uint16_t x, uint16_t y, uint16_t length);
+};
+
+#endif // HMS_STATUSLED_MATRIX_H
@@ -0,0 +1,52 @@
+#ifndef HMS_STATUSLED_STREAM_H
+#define HMS_STATUSLED_STREAM_H
+
+#include "HMS_StatusLED_DRIVER.h"
+
+#define HMS_STATUSLED_DDP_PORT            4048
+#define HMS_STATUSLED_E131_PORT           5568
+#define HMS_STATUSLED_ARTNET_PORT         6454
+
+typedef enum {
+  HMS_STATUSLED_STREAM_UNKNOWN = 0,
+  HMS_STATUSLED_STREAM_DDP,
+  HMS_STATUSLED_STREAM_E131,
+  HMS_STATUSLED_STREAM_ARTNET,
+} HMS_StatusLED_StreamProtocol;
+
+class HMS_StatusLED_StreamReceiver {                                                                      // Parses UDP payloads straight into the pixels of one strip
+  public:
+    HMS_StatusLED_StreamReceiver(HMS_StatusLED &driver, uint16_t startUniverse = 1, uint16_t pixelsPerUniverse = 170);
+
+    HMS_StatusLED_StatusTypeDef handlePacket(const uint8_t *packet, uint32_t length);                    // Protocol is detected from the header, shows the strip when a frame completes
+
+    HMS_StatusLED_StreamProtocol getLastProtocol() const                                            { return lastProtocol;      }
+    uint32_t getPacketCount() const                                                                 { return packetCount;       }  // Packets that updated pixels or completed a frame
+    uint32_t getDroppedPackets() const                                                              { return droppedPackets;    }  // Malformed, out of sequence or for other universes
+    uint32_t getFrameCount() const                                                                  { return frameCount;        }
+
+  private:
+    static_assert(HMS_STATUSLED_STREAM_MAX_UNIVERSES <= 32, "Received universes are tracked in a 32 bit mask");
+
+    HMS_StatusLED                       &driver;
+    uint16_t                            startUniverse;
+    uint16_t                            pixelsPerUniverse;
+    uint8_t                             universeCount;                                                    // Universes needed to cover the strip
+    uint32_t                            receivedMask;                                                     // Universes received since the last frame
+    uint32_t                            sequenceMask;                                                     // Universes with a valid lastSequence
+    uint8_t                             lastSequence[HMS_STATUSLED_STREAM_MAX_UNIVERSES];
+    bool                                syncMode;                                                         // A sync packet was seen, frames wait for the next one
+    HMS_StatusLED_StreamProtocol        lastProtocol;
+    uint32_t                            packetCount;
+    uint32_t                            droppedPackets;
+    uint32_t                            frameCount;
+
+    HMS_StatusLED_StatusTypeDef handleDDP(const uint8_t *packet, uint32_t length);
+    HMS_StatusLED_StatusTypeDef handleE131(const uint8_t *packet, uint32_t length);
+    HMS_StatusLED_StatusTypeDef handleArtNet(const uint8_t *packet, uint32_t length);
+    HMS_StatusLED_StatusTypeDef handleUniverse(uint16_t universe, uint8_t sequence, bool zeroDisablesSequence, const uint8_t *data, uint16_t length);
+    HMS_StatusLED_StatusTypeDef completeFrame();
+    HMS_StatusLED_StatusTypeDef drop();
+};
+
+#endif // HMS_STATUSLED_STREAM_H
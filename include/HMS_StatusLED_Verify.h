@@ -0,0 +1,54 @@
+#ifndef HMS_STATUSLED_VERIFY_H
+#define HMS_STATUSLED_VERIFY_H
+
+#include "HMS_StatusLED_DRIVER.h"
+
+typedef struct {
+  uint32_t                              bits;                                                             // Data bits before the latch
+  uint32_t                              bytes;                                                            // Complete bytes written to the output
+  uint32_t                              invalidBits;                                                      // High time or period outside the tolerance
+  uint32_t                              firstInvalidBit;                                                  // UINT32_MAX when all bits are valid
+  uint32_t                              t0hMinNs;
+  uint32_t                              t0hMaxNs;
+  uint32_t                              t1hMinNs;
+  uint32_t                              t1hMaxNs;
+  uint32_t                              periodMinNs;                                                      // The last bit has no period, its low time runs into the latch
+  uint32_t                              periodMaxNs;
+  uint32_t                              jitterNs;                                                         // Largest spread of T0H, T1H or the period
+  int32_t                               marginNs;                                                         // Closest distance to a tolerance limit, negative when violated
+  uint32_t                              resetNs;                                                          // Low time after the last bit
+  bool                                  resetOk;                                                          // resetNs reaches the latch time of the profile
+  uint32_t                              frameNs;                                                          // Data time plus the latch time of the profile
+  uint32_t                              maxFps;                                                           // Frames per second this stream allows back to back
+} HMS_StatusLED_WireReport;
+
+class HMS_StatusLED_WireDecoder {                                                                         // Rebuilds pixel bytes from an encoded stream and checks its timing
+  public:
+    HMS_StatusLED_WireDecoder(const HMS_StatusLED_Timing &timing, uint16_t toleranceNs = HMS_STATUSLED_VERIFY_TOLERANCE_NS,
+                              uint16_t periodToleranceNs = HMS_STATUSLED_VERIFY_TOLERANCE_NS);   // Pulse widths / bit period
+
+    void reset();                                                                                         // Drop all captured levels
+
+    void addCompareStream(const uint8_t *compare, uint32_t length, uint32_t periodTicks, uint16_t timerMHz);   // STM32 HAL / host: active for compare ticks of every timer period
+    void addRMTItems(const uint32_t *items, uint32_t count, uint16_t tickNs);                            // Legacy ESP32 RMT: raw rmt_item32_t words, a zero duration ends the stream
+    void addSPIStream(const uint8_t *bytes, uint32_t length, uint32_t spiHz);                            // Zephyr: SPI bits MSB first, each bit is the line level
+    void addWireBytes(const uint8_t *bytes, uint32_t length);                                            // Bit-bang / PIO / RMT bytes encoder: ideal pulses of the profile
+    void addIdle(uint32_t ns);                                                                           // Latch gap after a transfer
+
+    HMS_StatusLED_WireReport decode(uint8_t *bytes = nullptr, uint32_t maxBytes = 0) const;              // Wire bytes in transmit order (after color order, brightness, gamma)
+
+  private:
+    struct Run {
+      uint64_t                          ps;                                                               // Picoseconds, so timer ticks add up without rounding drift
+      bool                              active;                                                           // Line asserted (high, or low for inverted profiles)
+    };
+
+    HMS_StatusLED_Timing                timing;
+    uint16_t                            toleranceNs;
+    uint16_t                            periodToleranceNs;
+    std::vector<Run>                    runs;
+
+    void addLevel(bool active, uint64_t ps);
+};
+
+#endif // HMS_STATUSLED_VERIFY_H
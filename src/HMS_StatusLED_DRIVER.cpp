@@ -5,8 +5,127 @@
   ChronoLoger statusLEDLogger("HMS_StatusLED", HMS_STATUSLED_DEBUG_ENABLED);
 #endif
 
+/*
+    Levels below HMS_STATUSLED_LOG_LEVEL expand to nothing, the format strings and arguments are not even
+    evaluated. Per pixel and per frame paths never log, they record a trace event instead.
+*/
+#if defined(HMS_STATUSLED_LOGGER_ENABLED) && (HMS_STATUSLED_LOG_LEVEL >= 1)
+  #define HMS_STATUSLED_LOG_ERROR(...)       statusLEDLogger.error(__VA_ARGS__)
+#else
+  #define HMS_STATUSLED_LOG_ERROR(...)       ((void)0)
+#endif
+#if defined(HMS_STATUSLED_LOGGER_ENABLED) && (HMS_STATUSLED_LOG_LEVEL >= 2)
+  #define HMS_STATUSLED_LOG_INFO(...)        statusLEDLogger.info(__VA_ARGS__)
+#else
+  #define HMS_STATUSLED_LOG_INFO(...)        ((void)0)
+#endif
+#if defined(HMS_STATUSLED_LOGGER_ENABLED) && (HMS_STATUSLED_LOG_LEVEL >= 3)
+  #define HMS_STATUSLED_LOG_DEBUG(...)       statusLEDLogger.debug(__VA_ARGS__)
+#else
+  #define HMS_STATUSLED_LOG_DEBUG(...)       ((void)0)
+#endif
+
+#if defined(HMS_STATUSLED_TRACE_ENABLED) && (HMS_STATUSLED_TRACE_ENABLED == 1)
+  #if defined(HMS_STATUSLED_PLATFORM_ARDUINO)
+    #define HMS_STATUSLED_TRACE_CLOCK()      ((uint32_t)micros())
+  #elif defined(HMS_STATUSLED_PLATFORM_ESP_IDF)
+    #define HMS_STATUSLED_TRACE_CLOCK()      ((uint32_t)esp_timer_get_time())
+  #elif defined(HMS_STATUSLED_PLATFORM_ZEPHYR)
+    #define HMS_STATUSLED_TRACE_CLOCK()      (k_cyc_to_us_floor32(k_cycle_get_32()))
+  #elif defined(HMS_STATUSLED_PLATFORM_STM32_HAL) && defined(DWT)
+    #define HMS_STATUSLED_TRACE_CLOCK()      (DWT->CYCCNT / (SystemCoreClock / 1000000))                             // Cycle counter started by begin(), wraps with it (~25s at 168MHz)
+  #elif defined(HMS_STATUSLED_PLATFORM_STM32_HAL)
+    #define HMS_STATUSLED_TRACE_CLOCK()      (HAL_GetTick() * 1000)                                                  // Cortex-M0/M0+ have no DWT cycle counter, 1ms resolution
+  #elif defined(HMS_STATUSLED_PLATFORM_HOST)
+    #define HMS_STATUSLED_TRACE_CLOCK()      ((uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(            \
+                                                std::chrono::steady_clock::now().time_since_epoch()).count())
+  #endif
+
+  static_assert((HMS_STATUSLED_TRACE_DEPTH & (HMS_STATUSLED_TRACE_DEPTH - 1)) == 0,
+                "HMS_STATUSLED_TRACE_DEPTH must be a power of two");
+
+  static HMS_StatusLED_TraceRecord traceRing[HMS_STATUSLED_TRACE_DEPTH];
+  static uint32_t                  traceTail = 0;                                                                   // Records consumed by readTrace()
+
+  /*
+      Tasks, ISRs and a second core may trace at the same time, so the head (records written so far, the ring
+      index is its low bits) is advanced in one indivisible step and every writer owns the slot it got back.
+      Cortex-M0/M0+ have no atomic read-modify-write, a short interrupt mask (or the RP2040 hardware spin lock,
+      which also holds off the other core) stands in for it there.
+  */
+  #if defined(HMS_STATUSLED_PLATFORM_STM32_HAL) || defined(HMS_STATUSLED_PLATFORM_ARDUINO_SAMD)
+    static volatile uint32_t       traceHead = 0;
+
+    static inline uint32_t traceReserve() {
+        uint32_t primask = __get_PRIMASK();
+        __disable_irq();
+        uint32_t slot = traceHead++;
+        __set_PRIMASK(primask);                                                                                     // Interrupts stay masked if they already were
+        return slot;
+    }
+    #define HMS_STATUSLED_TRACE_HEAD()     (traceHead)
+  #elif defined(HMS_STATUSLED_PLATFORM_ARDUINO_RP2040)
+    static volatile uint32_t       traceHead = 0;
+
+    static inline uint32_t traceReserve() {
+        spin_lock_t *lock  = spin_lock_instance(PICO_SPINLOCK_ID_STRIPED_FIRST);                                   // Striped locks are shared by design, it is held for one increment
+        uint32_t    saved  = spin_lock_blocking(lock);
+        uint32_t    slot   = traceHead++;
+        spin_unlock(lock, saved);
+        return slot;
+    }
+    #define HMS_STATUSLED_TRACE_HEAD()     (traceHead)
+  #elif defined(HMS_STATUSLED_PLATFORM_ZEPHYR)
+    static atomic_t                traceHead = ATOMIC_INIT(0);
+
+    static inline uint32_t traceReserve() {
+        return (uint32_t)atomic_inc(&traceHead);                                                                    // Returns the value before the increment
+    }
+    #define HMS_STATUSLED_TRACE_HEAD()     ((uint32_t)atomic_get(&traceHead))
+  #else
+    #include <atomic>
+    static std::atomic<uint32_t>   traceHead{0};
+
+    static inline uint32_t traceReserve() {
+        return traceHead.fetch_add(1, std::memory_order_relaxed);
+    }
+    #define HMS_STATUSLED_TRACE_HEAD()     (traceHead.load(std::memory_order_relaxed))
+  #endif
+
+  static inline void traceRecord(uint8_t event, uint16_t arg0, uint32_t arg1) {                                    // Fixed size store, no formatting on the hot path
+      HMS_StatusLED_TraceRecord &record = traceRing[traceReserve() & (HMS_STATUSLED_TRACE_DEPTH - 1)];
+      record.timestamp = HMS_STATUSLED_TRACE_CLOCK();
+      record.event     = event;
+      record.reserved  = 0;
+      record.arg0      = arg0;
+      record.arg1      = arg1;
+  }
+
+  #define HMS_STATUSLED_TRACE(EVENT, ARG0, ARG1)   traceRecord((EVENT), (uint16_t)(ARG0), (uint32_t)(ARG1))
+#else
+  #define HMS_STATUSLED_TRACE(EVENT, ARG0, ARG1)   ((void)0)
+#endif
+
+#if defined(HMS_STATUSLED_PLATFORM_HOST)
+  #define HMS_STATUSLED_IDLE_SLOTS         2                                                                        // Same tail as the STM32 HAL backend
+#endif
+
 #if defined(HMS_STATUSLED_PLATFORM_STM32_HAL)
   TIM_HandleTypeDef* HMS_StatusLED::statusLED_hTim = nullptr;
+
+  #define HMS_STATUSLED_IDLE_SLOTS         2                                                                        // 0% duty periods after the last bit, the timer keeps running with the last compare value
+
+  /*
+      The latch is a timed gap after the DMA transfer instead of zero slots in the buffer. Cortex-M3 and
+      up time it with the DWT cycle counter, Cortex-M0/M0+ fall back to the 1ms HAL tick.
+  */
+  #if defined(DWT)
+    #define HMS_STATUSLED_LATCH_CLOCK()      (DWT->CYCCNT)
+    #define HMS_STATUSLED_US_TO_LATCH(US)    ((uint32_t)(US) * (SystemCoreClock / 1000000))
+  #else
+    #define HMS_STATUSLED_LATCH_CLOCK()      (HAL_GetTick())
+    #define HMS_STATUSLED_US_TO_LATCH(US)    (((uint32_t)(US) + 999) / 1000 + 1)                                     // +1 for the partially elapsed tick
+  #endif
 #endif
 
 #if (HMS_STATUSLED_GAMMA == true)
@@ -31,44 +150,479 @@ const uint8_t gammaLut[] = {
 
 #endif
 
-HMS_StatusLED::HMS_StatusLED(uint16_t maxPixels, HMS_StatusLED_Type type, HMS_StatusLED_OrderType colorOrder) 
-  : maxPixel(maxPixels), ledType(type), colorOrder(colorOrder), brightness(255), isOn(true) {
-  #ifdef HMS_STATUSLED_LOGGER_ENABLED
-    statusLEDLogger.debug("HMS_StatusLED Driver Instance created");
-  #endif
-    if (type == HMS_STATUSLED_TYPE_WS281XX) {
-        #if defined(HMS_STATUSLED_PLATFORM_ARDUINO_ESP32) || defined(HMS_STATUSLED_PLATFORM_ESP_IDF)
-            rmtItems = (rmt_item32_t*)malloc((maxPixel * 24 + 1) * sizeof(rmt_item32_t));                           // For ESP32, we'll use RMT items for efficient transmission (+1 for reset pulse)
-        #else
-            buffer.resize((maxPixel * 24) + 50, 0);                                                                 // For STM32 HAL, we'll use a buffer for DMA transmission
-        #endif
-        pixel.resize(maxPixel, std::vector<uint8_t>(3, 0));
-        originalPixel.resize(maxPixel, std::vector<uint8_t>(3, 0));                                                 // Initialize original pixel storage
-        lastState.resize(maxPixel, std::vector<uint8_t>(3, 0));                                                     // Initialize lastState storage
+const uint8_t expand5Lut[32] = {                                                                                    // 5-bit channel to 8 bits, top bits replicated (0x1F -> 0xFF)
+      0,   8,  16,  24,  33,  41,  49,  57,  66,  74,  82,  90,  99, 107, 115, 123,
+    132, 140, 148, 156, 165, 173, 181, 189, 198, 206, 214, 222, 231, 239, 247, 255
+};
+
+const uint8_t expand6Lut[64] = {                                                                                    // 6-bit channel to 8 bits, top bits replicated (0x3F -> 0xFF)
+      0,   4,   8,  12,  16,  20,  24,  28,  32,  36,  40,  44,  48,  52,  56,  60,
+     65,  69,  73,  77,  81,  85,  89,  93,  97, 101, 105, 109, 113, 117, 121, 125,
+    130, 134, 138, 142, 146, 150, 154, 158, 162, 166, 170, 174, 178, 182, 186, 190,
+    195, 199, 203, 207, 211, 215, 219, 223, 227, 231, 235, 239, 243, 247, 251, 255
+};
+
+const uint8_t sineLut[256] = {                                                                                      // (1 - cos) / 2 over one period: 0 at both ends, 255 in the middle
+      0,   0,   0,   0,   1,   1,   1,   2,   2,   3,   4,   5,   5,   6,   7,   9,
+     10,  11,  12,  14,  15,  17,  18,  20,  21,  23,  25,  27,  29,  31,  33,  35,
+     37,  40,  42,  44,  47,  49,  52,  54,  57,  59,  62,  65,  67,  70,  73,  76,
+     79,  82,  85,  88,  90,  93,  97, 100, 103, 106, 109, 112, 115, 118, 121, 124,
+    127, 131, 134, 137, 140, 143, 146, 149, 152, 155, 158, 162, 165, 167, 170, 173,
+    176, 179, 182, 185, 188, 190, 193, 196, 198, 201, 203, 206, 208, 211, 213, 215,
+    218, 220, 222, 224, 226, 228, 230, 232, 234, 235, 237, 238, 240, 241, 243, 244,
+    245, 246, 248, 249, 250, 250, 251, 252, 253, 253, 254, 254, 254, 255, 255, 255,
+    255, 255, 255, 255, 254, 254, 254, 253, 253, 252, 251, 250, 250, 249, 248, 246,
+    245, 244, 243, 241, 240, 238, 237, 235, 234, 232, 230, 228, 226, 224, 222, 220,
+    218, 215, 213, 211, 208, 206, 203, 201, 198, 196, 193, 190, 188, 185, 182, 179,
+    176, 173, 170, 167, 165, 162, 158, 155, 152, 149, 146, 143, 140, 137, 134, 131,
+    128, 124, 121, 118, 115, 112, 109, 106, 103, 100,  97,  93,  90,  88,  85,  82,
+     79,  76,  73,  70,  67,  65,  62,  59,  57,  54,  52,  49,  47,  44,  42,  40,
+     37,  35,  33,  31,  29,  27,  25,  23,  21,  20,  18,  17,  15,  14,  12,  11,
+     10,   9,   7,   6,   5,   5,   4,   3,   2,   2,   1,   1,   1,   0,   0,   0
+};
+
+const uint8_t easeLut[256] = {                                                                                      // Smoothstep 3t^2 - 2t^3, soft start and end of fades
+      0,   0,   0,   0,   0,   0,   0,   1,   1,   1,   1,   1,   2,   2,   2,   3,
+      3,   3,   4,   4,   4,   5,   5,   6,   6,   7,   7,   8,   9,   9,  10,  10,
+     11,  12,  12,  13,  14,  15,  15,  16,  17,  18,  18,  19,  20,  21,  22,  23,
+     24,  25,  26,  27,  27,  28,  29,  30,  31,  33,  34,  35,  36,  37,  38,  39,
+     40,  41,  42,  44,  45,  46,  47,  48,  50,  51,  52,  53,  54,  56,  57,  58,
+     60,  61,  62,  63,  65,  66,  67,  69,  70,  72,  73,  74,  76,  77,  78,  80,
+     81,  83,  84,  85,  87,  88,  90,  91,  93,  94,  96,  97,  98, 100, 101, 103,
+    104, 106, 107, 109, 110, 112, 113, 115, 116, 118, 119, 121, 122, 124, 125, 127,
+    128, 130, 131, 133, 134, 136, 137, 139, 140, 142, 143, 145, 146, 148, 149, 151,
+    152, 154, 155, 157, 158, 159, 161, 162, 164, 165, 167, 168, 170, 171, 172, 174,
+    175, 177, 178, 179, 181, 182, 183, 185, 186, 188, 189, 190, 192, 193, 194, 195,
+    197, 198, 199, 201, 202, 203, 204, 205, 207, 208, 209, 210, 211, 213, 214, 215,
+    216, 217, 218, 219, 220, 221, 222, 224, 225, 226, 227, 228, 228, 229, 230, 231,
+    232, 233, 234, 235, 236, 237, 237, 238, 239, 240, 240, 241, 242, 243, 243, 244,
+    245, 245, 246, 246, 247, 248, 248, 249, 249, 250, 250, 251, 251, 251, 252, 252,
+    252, 253, 253, 253, 254, 254, 254, 254, 254, 255, 255, 255, 255, 255, 255, 255
+};
+
+static inline void expand565(uint16_t color, uint8_t &r, uint8_t &g, uint8_t &b) {
+    r = expand5Lut[color >> 11];
+    g = expand6Lut[(color >> 5) & 0x3F];
+    b = expand5Lut[color & 0x1F];
+}
+
+static inline void applyGamma(uint8_t &r, uint8_t &g, uint8_t &b) {
+    #if (HMS_STATUSLED_GAMMA == true)
+        r = gammaLut[r];    g = gammaLut[g];    b = gammaLut[b];
+    #else
+        (void)r;    (void)g;    (void)b;
+    #endif
+}
+
+static inline void hsvToRgb(uint8_t hue, uint8_t saturation, uint8_t value, uint8_t &r, uint8_t &g, uint8_t &b) {
+    static const uint8_t sectorShape[6][3] = {                                                                      // Level used by R, G, B in each 60° sector
+        {3, 1, 0},  {2, 3, 0},  {0, 3, 1},  {0, 2, 3},  {1, 0, 3},  {3, 0, 2}                                       // 0 = off, 1 = rising, 2 = falling, 3 = full
+    };
+    uint16_t position  = (uint16_t)hue * 6;                                                                         // Sector in the high byte, position inside it in the low byte
+    uint8_t  rise      = position & 0xFF;
+    uint8_t  levels[4] = { 0, rise, (uint8_t)(255 - rise), 255 };
+
+    for (uint8_t i = 0; i < 4; i++) {                                                                               // Saturation pulls towards white, value scales towards black
+        uint8_t level = 255 - (((255 - levels[i]) * (saturation + 1)) >> 8);
+        levels[i] = (level * (value + 1)) >> 8;
+    }
+
+    const uint8_t *shape = sectorShape[position >> 8];
+    r = levels[shape[0]];   g = levels[shape[1]];   b = levels[shape[2]];
+}
+
+static inline uint32_t blendPacked(uint32_t below, uint32_t above, uint16_t weight) {                             // weight 0-256, all four bytes per call
+    uint32_t even = (((below & 0x00FF00FF) * (256 - weight) + (above & 0x00FF00FF) * weight) >> 8) & 0x00FF00FF;    // Bytes 0 and 2 in 16-bit lanes, no carry between lanes
+    uint32_t odd  = ((((below >> 8) & 0x00FF00FF) * (256 - weight) + ((above >> 8) & 0x00FF00FF) * weight)) & 0xFF00FF00;
+    return even | odd;
+}
+
+static inline uint32_t scalePacked(uint32_t color, uint16_t weight) {                                              // weight 0-256
+    return (((color & 0x00FF00FF) * weight >> 8) & 0x00FF00FF) | ((((color >> 8) & 0x00FF00FF) * weight) & 0xFF00FF00);
+}
+
+static inline uint32_t addSaturatePacked(uint32_t a, uint32_t b) {                                                 // Per byte a + b clamped to 255
+    uint32_t sum      = (a & 0x7F7F7F7F) + (b & 0x7F7F7F7F);                                                        // Low 7 bits, carries stop at bit 7 of each byte
+    uint32_t overflow = ((a & b) | ((a | b) & sum)) & 0x80808080;                                                   // Carry out of bit 7 (sum bit 7 is the carry into it)
+    return ((sum ^ ((a ^ b) & 0x80808080)) | ((overflow >> 7) * 0xFF));
+}
+
+static inline uint16_t sineAt(uint16_t phase) {                                                                     // sineLut interpolated, 8.8 fixed point (0 - 65280)
+    uint8_t a = sineLut[phase >> 8], b = sineLut[(uint8_t)((phase >> 8) + 1)];
+    return (a << 8) + (b - a) * (phase & 0xFF);
+}
+
+static inline uint16_t easeWeight(int32_t x) {                                                                      // x 0-256 through easeLut, result 0-256
+    uint8_t e = easeLut[x - (x >> 8)];
+    return e + (e >> 7);
+}
+
+static inline int32_t clampRange(int32_t x, int32_t limit) {                                                        // 0 <= x <= limit without branches
+    x &= ~(x >> 31);
+    int32_t over = x - limit;
+    return limit + (over & (over >> 31));
+}
+
+static inline uint32_t hashPixel(uint32_t pixel, uint32_t cycle) {                                                  // Stateless noise per pixel and cycle
+    uint32_t x = pixel * 0x9E3779B1UL ^ cycle * 0x85EBCA77UL;
+    x ^= x >> 16;   x *= 0x7FEB352DUL;
+    x ^= x >> 15;   x *= 0x846CA68BUL;
+    return x ^ (x >> 16);
+}
+
+static inline uint8_t ditherThreshold(uint8_t phase) {                                                              // Bit reversed counter: a fraction f wins f of every 256 frames, evenly spread
+    static const uint8_t reversedNibble[16] = {0x0, 0x8, 0x4, 0xC, 0x2, 0xA, 0x6, 0xE, 0x1, 0x9, 0x5, 0xD, 0x3, 0xB, 0x7, 0xF};
+    return (reversedNibble[phase & 0x0F] << 4) | reversedNibble[phase >> 4];
+}
+
+/*
+    Fastest timings inside each datasheet's tolerance. Reset lengths follow the current datasheet
+    revisions (e.g. WS2812B V5 / WS2813 need 280µs, older parts latch after 50µs).
+*/
+static const HMS_StatusLED_Timing timingProfiles[] = {
+    //  bitNs   t0hNs   t1hNs   resetUs     inverted
+    {   HMS_STATUSLED_PULSE_LENGTH_NS, HMS_STATUSLED_PULSE_0_NS, HMS_STATUSLED_PULSE_1_NS, HMS_STATUSLED_RESET_US, false },   // WS281XX (config macros)
+    {   1250,   250,    600,    50,         false   },                                                              // WS2811 800kHz
+    {   2500,   500,    1200,   50,         false   },                                                              // WS2811 400kHz
+    {   1250,   400,    800,    280,        false   },                                                              // WS2812B
+    {   1250,   300,    750,    280,        false   },                                                              // WS2813
+    {   1250,   300,    600,    80,         false   },                                                              // SK6812
+    {   1250,   360,    720,    200,        true    },                                                              // TM1814
+};
+
+const HMS_StatusLED_Timing& HMS_StatusLED::getTimingProfile(HMS_StatusLED_Type type) {
+    if (type >= sizeof(timingProfiles) / sizeof(timingProfiles[0])) {
+        return timingProfiles[HMS_STATUSLED_TYPE_WS281XX];                                                          // Custom timings are not in the table
+    }
+    return timingProfiles[type];
+}
+
+/*
+    Zephyr sends each LED bit as one SPI byte. SPI controllers only divide their clock by powers of two
+    (nRF52 SPIM: 8MHz down to 125kHz), so the clock is the step whose byte is closest to the bit length:
+    8MHz gives 1000ns bits for a 1250ns profile, inside the ±600ns period tolerance of the datasheets.
+    The high time of a 0/1 bit is the number of leading ones at that clock, an inverted strip gets the
+    complemented patterns (MOSI must idle high for it). Platform independent, so the host can check it.
+*/
+uint32_t HMS_StatusLED::getSPIPatterns(const HMS_StatusLED_Timing &timing, uint8_t &pulse0, uint8_t &pulse1) {
+    uint32_t frequency = HMS_STATUSLED_SPI_MAX_HZ;
+    while (frequency > 125000 && 8000000000ULL / frequency + 4000000000ULL / frequency < timing.bitNs) {
+        frequency /= 2;                                                                                             // Halving gets closer while the bit is over 1.5 bytes
+    }
+
+    uint32_t spiBitNs  = 1000000000UL / frequency;
+    uint8_t  highBits0 = (uint8_t)((timing.t0hNs + spiBitNs / 2) / spiBitNs);
+    uint8_t  highBits1 = (uint8_t)((timing.t1hNs + spiBitNs / 2) / spiBitNs);
+    if (highBits0 < 1) highBits0 = 1;                                                                               // A 0 bit still needs a pulse, a 1 bit a low tail
+    if (highBits1 > 7) highBits1 = 7;
+    if (highBits1 <= highBits0) highBits1 = highBits0 + 1;
+    pulse0 = (uint8_t)(0xFF00 >> highBits0);                                                                        // e.g. 3 high bits -> 0xE0
+    pulse1 = (uint8_t)(0xFF00 >> highBits1);                                                                        // e.g. 6 high bits -> 0xFC
+    if (timing.inverted) {
+        pulse0 = ~pulse0;
+        pulse1 = ~pulse1;
     }
+    return frequency;
+}
+
+HMS_StatusLED::HMS_StatusLED(uint16_t maxPixels, HMS_StatusLED_Type type, HMS_StatusLED_OrderType colorOrder)
+  : HMS_StatusLED(maxPixels, getTimingProfile(type), colorOrder) {
+    ledType = type;
+}
+
+HMS_StatusLED::HMS_StatusLED(uint16_t maxPixels, const HMS_StatusLED_Timing &timing, HMS_StatusLED_OrderType colorOrder)
+  : maxPixel(maxPixels), ledType(HMS_STATUSLED_TYPE_CUSTOM), colorOrder(colorOrder), timing(timing), brightness(255), brightness16(65535), isOn(true),
+    offFrameReady(false), channelSum(0), powerBudget(0), milliAmpsPerChannel(HMS_STATUSLED_DEFAULT_MA_PER_CHANNEL), paletteBits(0),
+    dirtyStart(0), dirtyEnd(0) {
+    HMS_STATUSLED_LOG_INFO("HMS_StatusLED Driver Instance created");
+    #if defined(HMS_STATUSLED_ESP_RMT_LEGACY)
+        rmtItems = (rmt_item32_t*)malloc((maxPixel * 24) * sizeof(rmt_item32_t));                                   // For ESP32, we'll use RMT items for efficient transmission
+    #elif defined(HMS_STATUSLED_PLATFORM_ARDUINO) || defined(HMS_STATUSLED_PLATFORM_ESP_IDF)
+        buffer.resize(maxPixel * 3, 0);                                                                             // For bit-bang / PIO / RMT bytes encoder, the buffer holds the final wire bytes
+    #elif defined(HMS_STATUSLED_PLATFORM_ZEPHYR)
+        buffer.resize(maxPixel * 24, 0);                                                                            // For Zephyr, one SPI byte per bit, the latch is a timed gap
+    #else
+        buffer.resize((maxPixel * 24) + HMS_STATUSLED_IDLE_SLOTS, 0);                                               // For STM32 HAL and the host, we'll use a buffer for DMA transmission
+    #endif
+    pixel.resize(maxPixel, std::vector<uint8_t>(3, 0));
+    originalPixel.resize(maxPixel, std::vector<uint8_t>(3, 0));                                                     // Initialize original pixel storage
+    #if defined(HMS_STATUSLED_HAS_COMMAND_QUEUE)
+        setMaxFps(HMS_STATUSLED_MAX_FPS);
+        #if defined(HMS_STATUSLED_PLATFORM_ZEPHYR)
+            k_sem_init(&commandReady, 0, K_SEM_MAX_LIMIT);
+        #endif
+    #endif
+    #if defined(HMS_STATUSLED_PLATFORM_ZEPHYR)
+        k_sem_init(&transferDone, 1, 1);                                                                            // Bus starts idle, also before begin()
+    #endif
 }
 
 HMS_StatusLED::~HMS_StatusLED() {
-    #ifdef HMS_STATUSLED_LOGGER_ENABLED
-      statusLEDLogger.debug("HMS_StatusLED Driver Instance destroyed");
+    HMS_STATUSLED_LOG_INFO("HMS_StatusLED Driver Instance destroyed");
+
+    #if defined(HMS_STATUSLED_HAS_COMMAND_QUEUE)
+        stopTask();                                                                                                 // The LED task must not outlive the buffers
     #endif
     
-    #if defined(HMS_STATUSLED_PLATFORM_ARDUINO_ESP32) || defined(HMS_STATUSLED_PLATFORM_ESP_IDF)
+    #if defined(HMS_STATUSLED_ESP_RMT_LEGACY)
+        waitForTransfer();
         if (rmtItems) {
             free(rmtItems);
             rmtItems = nullptr;
         }
         rmt_driver_uninstall(rmtChannel);                                                                           // Deinitialize RMT channel
+    #elif defined(HMS_STATUSLED_PLATFORM_ARDUINO_ESP32) || defined(HMS_STATUSLED_PLATFORM_ESP_IDF)
+        if (rmtChannel) {
+            waitForTransfer();                                                                                      // DMA may still be reading the buffer
+            rmt_disable(rmtChannel);
+            rmt_del_channel(rmtChannel);
+        }
+        if (bytesEncoder)   rmt_del_encoder(bytesEncoder);
+        if (transferDone)   vSemaphoreDelete(transferDone);
+        buffer.clear();
+    #elif defined(HMS_STATUSLED_PLATFORM_ZEPHYR)
+        waitForTransfer();                                                                                          // SPI may still be reading the buffer
+        buffer.clear();
+    #elif defined(HMS_STATUSLED_PLATFORM_ARDUINO_RP2040)
+        waitForTransfer();                                                                                          // DMA may still be reading the buffer
+        releasePIO();
+        buffer.clear();
     #else
         buffer.clear();
     #endif
     pixel.clear();
     originalPixel.clear();
-    lastState.clear();
 }
 
 #if defined(HMS_STATUSLED_PLATFORM_ARDUINO) && !defined(HMS_STATUSLED_PLATFORM_ARDUINO_ESP32)
-#elif defined(HMS_STATUSLED_PLATFORM_ARDUINO_ESP32) || defined(HMS_STATUSLED_PLATFORM_ESP_IDF)
+#if defined(HMS_STATUSLED_PLATFORM_ARDUINO_SAMD)
+/*
+    Cortex-M0+ has no cycle counter, SysTick (clocked from the CPU, counting down) is used instead.
+    Both edges of a bit are timed from its start, so loop overhead does not accumulate.
+    Interrupts are masked for one pixel (~30µs) at a time, not for the frame: SysTick wraps every 1ms
+    and only one of its exceptions can be pending, so a longer mask would lose millis() ticks. Between
+    pixels the line idles low while pending interrupts run, far below any latch time.
+*/
+#define HMS_STATUSLED_NS_TO_CYCLES(NS)     ((uint32_t)(((uint64_t)F_CPU * (NS) + 500000000ULL) / 1000000000ULL))
+
+static inline uint32_t elapsedCycles(uint32_t start, uint32_t reload) {
+    uint32_t now = SysTick->VAL;
+    return (start >= now) ? start - now : start + reload + 1 - now;
+}
+
+static void sendWireBytes(volatile uint32_t *port, uint32_t mask, bool inverted, uint32_t t0h, uint32_t t1h, uint32_t period,
+                          const uint8_t *data, uint32_t length) {
+    const uint32_t reload    = SysTick->LOAD;
+    const uint32_t activeSet = inverted ? 0 : mask;                                                                 // Port bit value while the pulse is high
+
+    while (length) {
+        uint32_t count = (length < HMS_STATUSLED_SLOTS_PER_PIXEL) ? length : HMS_STATUSLED_SLOTS_PER_PIXEL;
+        length -= count;
+
+        noInterrupts();                                                                                             // SysTick keeps counting, only its interrupt is held off
+        while (count--) {
+            uint8_t value = *data++;
+            for (uint8_t bit = 0x80; bit; bit >>= 1) {
+                uint32_t start = SysTick->VAL;
+                uint32_t high  = (value & bit) ? t1h : t0h;
+
+                *port = (*port & ~mask) | activeSet;
+                while (elapsedCycles(start, reload) < high);
+                *port = (*port & ~mask) | (activeSet ^ mask);
+                while (elapsedCycles(start, reload) < period);
+            }
+        }
+        interrupts();                                                                                               // Pending SysTick / UART interrupts run between pixels
+    }
+}
+#elif defined(HMS_STATUSLED_PLATFORM_ARDUINO_RP2040)
+/*
+    WS2812 PIO program (pico-examples ws2812.pio), 10 PIO cycles per bit: T1=2, T2=5, T3=3.
+    Autopull every 8 bits, so the DMA streams the wire bytes straight into the TX FIFO.
+    begin() rewrites the delay fields (bits 8-11) so T1/T2/T3 follow the instance timing profile.
+*/
+#define HMS_STATUSLED_PIO_CYCLES_PER_BIT   10
+
+static const uint16_t ws2812Instructions[] = {
+    0x6221,                                                                                                         //  0: out    x, 1            side 0 [2]
+    0x1123,                                                                                                         //  1: jmp    !x, 3           side 1 [1]
+    0x1400,                                                                                                         //  2: jmp    0               side 1 [4]
+    0xa442,                                                                                                         //  3: nop                    side 0 [4]
+};
+
+static inline uint16_t withDelay(uint16_t instruction, uint8_t cycles) {
+    return (uint16_t)((instruction & ~0x0F00) | ((cycles - 1) << 8));
+}
+#else
+  #error "HMS_StatusLED: unsupported Arduino architecture (SAMD, RP2040 and ESP32 are supported)"
+#endif
+
+HMS_StatusLED_StatusTypeDef HMS_StatusLED::begin(uint8_t pin) {
+    outputPin = pin;
+    pinMode(pin, OUTPUT);
+    digitalWrite(pin, timing.inverted ? HIGH : LOW);                                                                // Idle level
+
+    #if defined(HMS_STATUSLED_PLATFORM_ARDUINO_SAMD)
+        outputPort = portOutputRegister(digitalPinToPort(pin));
+        outputMask = digitalPinToBitMask(pin);
+        t0hCycles  = HMS_STATUSLED_NS_TO_CYCLES(timing.t0hNs);
+        t1hCycles  = HMS_STATUSLED_NS_TO_CYCLES(timing.t1hNs);
+        bitCycles  = HMS_STATUSLED_NS_TO_CYCLES(timing.bitNs);
+    #elif defined(HMS_STATUSLED_PLATFORM_ARDUINO_RP2040)
+        uint8_t t1 = (uint8_t)((timing.t0hNs * HMS_STATUSLED_PIO_CYCLES_PER_BIT + timing.bitNs / 2) / timing.bitNs);
+        uint8_t t2 = (uint8_t)((timing.t1hNs * HMS_STATUSLED_PIO_CYCLES_PER_BIT + timing.bitNs / 2) / timing.bitNs) - t1;
+        uint8_t t3 = HMS_STATUSLED_PIO_CYCLES_PER_BIT - t1 - t2;
+        uint16_t instructions[4] = {
+            withDelay(ws2812Instructions[0], t3),
+            withDelay(ws2812Instructions[1], t1),
+            withDelay(ws2812Instructions[2], t2),
+            withDelay(ws2812Instructions[3], t2),
+        };
+        const struct pio_program ws2812Program = { instructions, 4, -1 };                                          // Copied into PIO memory by pio_add_program()
+
+        pio          = pio0;
+        stateMachine = pio_claim_unused_sm(pio, false);
+        if (stateMachine < 0 || !pio_can_add_program(pio, &ws2812Program)) {
+            if (stateMachine >= 0) pio_sm_unclaim(pio, stateMachine);
+            pio          = pio1;
+            stateMachine = pio_claim_unused_sm(pio, false);
+        }
+        if (stateMachine < 0 || !pio_can_add_program(pio, &ws2812Program)) {
+            if (stateMachine >= 0) pio_sm_unclaim(pio, stateMachine);                                               // pio1 had a state machine but no room for the program
+            stateMachine = -1;
+            HMS_STATUSLED_LOG_ERROR("No free PIO state machine");
+            return HMS_STATUSLED_ERROR;
+        }
+
+        uint offset   = pio_add_program(pio, &ws2812Program);
+        programOffset = (uint8_t)offset;
+        pio_gpio_init(pio, pin);
+        pio_sm_set_consecutive_pindirs(pio, stateMachine, pin, 1, true);
+
+        pio_sm_config smConfig = pio_get_default_sm_config();
+        sm_config_set_wrap(&smConfig, offset, offset + 3);
+        sm_config_set_sideset(&smConfig, 1, false, false);
+        sm_config_set_sideset_pins(&smConfig, pin);
+        sm_config_set_out_shift(&smConfig, false, true, 8);                                                         // MSB first, autopull one wire byte at a time
+        sm_config_set_fifo_join(&smConfig, PIO_FIFO_JOIN_TX);
+        sm_config_set_clkdiv(&smConfig, clock_get_hz(clk_sys) / (1000000000.0f / timing.bitNs * HMS_STATUSLED_PIO_CYCLES_PER_BIT));
+        if (timing.inverted) {
+            gpio_set_outover(pin, GPIO_OVERRIDE_INVERT);                                                            // Inverted after the PIO, the program stays the same
+        }
+        pio_sm_init(pio, stateMachine, offset, &smConfig);
+        pio_sm_set_enabled(pio, stateMachine, true);
+
+        dmaChannel = dma_claim_unused_channel(false);
+        if (dmaChannel < 0) {
+            releasePIO();                                                                                           // No half set up state machine is left running
+            HMS_STATUSLED_LOG_ERROR("No free DMA channel");
+            return HMS_STATUSLED_ERROR;
+        }
+
+        dma_channel_config dmaConfig = dma_channel_get_default_config(dmaChannel);
+        channel_config_set_transfer_data_size(&dmaConfig, DMA_SIZE_8);                                              // Byte writes are replicated across the FIFO word, top byte is shifted out
+        channel_config_set_read_increment(&dmaConfig, true);
+        channel_config_set_write_increment(&dmaConfig, false);
+        channel_config_set_dreq(&dmaConfig, pio_get_dreq(pio, stateMachine, true));
+        dma_channel_configure(dmaChannel, &dmaConfig, &pio->txf[stateMachine], NULL, 0, false);
+    #endif
+
+    clear();
+
+    HMS_STATUSLED_LOG_INFO("HMS_StatusLED Driver Started on pin %d", pin);
+
+    return HMS_STATUSLED_OK;
+}
+
+#if defined(HMS_STATUSLED_PLATFORM_ARDUINO_RP2040)
+void HMS_StatusLED::releasePIO() {
+    if (dmaChannel >= 0) {
+        dma_channel_wait_for_finish_blocking(dmaChannel);
+        dma_channel_unclaim(dmaChannel);
+        dmaChannel = -1;
+    }
+    if (stateMachine >= 0) {
+        const struct pio_program ws2812Program = { ws2812Instructions, 4, -1 };                                    // Only the length is needed to free the instruction memory
+        pio_sm_set_enabled(pio, stateMachine, false);
+        pio_remove_program(pio, &ws2812Program, programOffset);
+        pio_sm_unclaim(pio, stateMachine);
+        stateMachine = -1;
+
+        gpio_set_outover(outputPin, GPIO_OVERRIDE_NORMAL);
+        pinMode(outputPin, OUTPUT);                                                                                 // Back from the PIO to a plain GPIO at the idle level
+        digitalWrite(outputPin, timing.inverted ? HIGH : LOW);
+    }
+}
+#endif
+
+void HMS_StatusLED::encodeByte(uint8_t colorValue, HMS_StatusLED_EncodedSlot *slots) {
+    *slots = colorValue;                                                                                            // Bits are generated on the fly by the bit-bang loop / PIO
+}
+
+void HMS_StatusLED::updateWireBuffer() {
+    if (!isOn) {                                                                                                    // Off frame is encoded once and then reused as is
+        if (offFrameReady) return;
+        std::fill(buffer.begin(), buffer.end(), 0);
+        offFrameReady = true;
+    } else {
+        uint32_t bufferIndex = 0;
+        encodeFrame(bufferIndex);
+        offFrameReady = false;
+    }
+}
+
+HMS_StatusLED_EncodedSlot* HMS_StatusLED::encodedData() {
+    return buffer.data();
+}
+
+uint32_t HMS_StatusLED::encodedLength() const {
+    return buffer.size();
+}
+
+void HMS_StatusLED::waitForTransfer() {
+    #if defined(HMS_STATUSLED_PLATFORM_ARDUINO_RP2040)
+        if (dmaChannel >= 0) dma_channel_wait_for_finish_blocking(dmaChannel);
+    #endif
+    while ((uint32_t)(micros() - frameStart) < frameHold);                                                        // Only the remainder of the frame and latch time is waited out
+}
+
+HMS_StatusLED_StatusTypeDef HMS_StatusLED::transmit(const HMS_StatusLED_EncodedSlot *data, uint32_t length) {
+    #if defined(HMS_STATUSLED_PLATFORM_ARDUINO_SAMD)
+        if (!outputPort) {
+            HMS_STATUSLED_LOG_ERROR("Pin not initialized. Call begin() first.");
+            return HMS_STATUSLED_ERROR;
+        }
+        waitForTransfer();
+        sendWireBytes(outputPort, outputMask, timing.inverted, t0hCycles, t1hCycles, bitCycles, data, length);
+        frameStart = micros();                                                                                      // Interrupts were masked, micros() only counts from here
+        frameHold  = timing.resetUs;
+    #elif defined(HMS_STATUSLED_PLATFORM_ARDUINO_RP2040)
+        if (dmaChannel < 0) {
+            HMS_STATUSLED_LOG_ERROR("PIO not initialized. Call begin() first.");
+            return HMS_STATUSLED_ERROR;
+        }
+        waitForTransfer();
+        dma_channel_transfer_from_buffer_now(dmaChannel, data, length);                                             // CPU is free while the frame streams out
+        frameStart = micros();
+        frameHold  = (length * 8 * timing.bitNs) / 1000 + timing.resetUs;                                          // The FIFO still shifts out after the DMA ends
+    #endif
+
+    return HMS_STATUSLED_OK;
+}
+
+HMS_StatusLED_StatusTypeDef HMS_StatusLED::show() {
+    waitForTransfer();                                                                                              // The encoder must not overwrite a frame still streaming out
+    updateWireBuffer();
+
+    if (transmit(buffer.data(), buffer.size()) != HMS_STATUSLED_OK) {
+        return HMS_STATUSLED_ERROR;
+    }
+
+    HMS_STATUSLED_TRACE(HMS_STATUSLED_TRACE_SHOW, 0, encodedLength());
+
+    return HMS_STATUSLED_OK;
+}
+#elif defined(HMS_STATUSLED_ESP_RMT_LEGACY)
 HMS_StatusLED_StatusTypeDef HMS_StatusLED::begin(uint8_t pin, rmt_channel_t channel) {
     outputPin = pin;
     rmtChannel = channel;
@@ -77,355 +631,2398 @@ HMS_StatusLED_StatusTypeDef HMS_StatusLED::begin(uint8_t pin, rmt_channel_t chan
     rmtConfig.rmt_mode = RMT_MODE_TX;
     rmtConfig.channel = rmtChannel;
     rmtConfig.gpio_num = (gpio_num_t)pin;
-    rmtConfig.clk_div = 2;                                                                                          // 40MHz (80MHz / 2)
+    rmtConfig.clk_div = 2;                                                                                          // 40MHz (80MHz / 2), 25ns per tick
     rmtConfig.mem_block_num = 1;
     rmtConfig.flags = 0;
     
     rmtConfig.tx_config.carrier_en = false;
     rmtConfig.tx_config.loop_en = false;
-    rmtConfig.tx_config.idle_level = RMT_IDLE_LEVEL_LOW;
+    rmtConfig.tx_config.idle_level = timing.inverted ? RMT_IDLE_LEVEL_HIGH : RMT_IDLE_LEVEL_LOW;
     rmtConfig.tx_config.idle_output_en = true;
     
     esp_err_t result = rmt_config(&rmtConfig);                                                                      // Configure RMT
     if (result != ESP_OK) {
-        #ifdef HMS_STATUSLED_LOGGER_ENABLED
-            statusLEDLogger.debug("Error: RMT configuration failed");
-        #endif
+        HMS_STATUSLED_LOG_ERROR("RMT configuration failed");
         return HMS_STATUSLED_ERROR;
     }
     
     result = rmt_driver_install(rmtChannel, 0, 0);                                                                  // Install RMT driver
     if (result != ESP_OK) {
-        #ifdef HMS_STATUSLED_LOGGER_ENABLED
-            statusLEDLogger.debug("Error: RMT driver installation failed");
-        #endif
+        HMS_STATUSLED_LOG_ERROR("RMT driver installation failed");
         return HMS_STATUSLED_ERROR;
     }
     
+    uint32_t active = timing.inverted ? 0 : 1;                                                                      // Pre-compute the items of both bit values
+    bitItems[0].level0 = active;    bitItems[0].duration0 = (timing.t0hNs + 12) / 25;
+    bitItems[0].level1 = !active;   bitItems[0].duration1 = (timing.bitNs - timing.t0hNs + 12) / 25;
+    bitItems[1].level0 = active;    bitItems[1].duration0 = (timing.t1hNs + 12) / 25;
+    bitItems[1].level1 = !active;   bitItems[1].duration1 = (timing.bitNs - timing.t1hNs + 12) / 25;
+
     clear();                                                                                                        // Clear pixels
     
-    #ifdef HMS_STATUSLED_LOGGER_ENABLED
-        statusLEDLogger.debug("ESP32 RMT Driver Started on pin %d, channel %d", pin, rmtChannel);
-    #endif
+    HMS_STATUSLED_LOG_INFO("ESP32 RMT Driver Started on pin %d, channel %d", pin, rmtChannel);
     
     return HMS_STATUSLED_OK;
 }
 
+void HMS_StatusLED::encodeByte(uint8_t colorValue, HMS_StatusLED_EncodedSlot *items) {
+    for (int8_t bit = 7; bit >= 0; bit--, items++) {                                                                // Convert each bit to the pre-computed RMT item of the timing profile
+        *items = bitItems[(colorValue >> bit) & 1];
+    }
+}
+
 void HMS_StatusLED::updateRMTBuffer() {
     if (!rmtItems) return;
     
     uint32_t itemIndex = 0;
-    
-    for (uint16_t pixelIdx = 0; pixelIdx < maxPixel; pixelIdx++) {                                                  // Convert pixel data to RMT items
-        for (uint8_t colorComponent = 0; colorComponent < 3; colorComponent++) {
-            uint8_t colorValue = pixel[pixelIdx][colorComponent];
-            
-            for (int8_t bit = 7; bit >= 0; bit--) {                                                                 // Convert each bit to RMT item (WS2812B timing)
-                if (colorValue & (1 << bit)) {
-                    rmtItems[itemIndex].level0 = 1;                                                                 // High bit: T1H=0.8µs, T1L=0.45µs (32 ticks, 18 ticks at 40MHz)
-                    rmtItems[itemIndex].duration0 = 32;                                                             // 0.8µs
-                    rmtItems[itemIndex].level1 = 0;
-                    rmtItems[itemIndex].duration1 = 18;                                                             // 0.45µs
-                } else {
-                    rmtItems[itemIndex].level0 = 1;                                                                 // Low bit: T0H=0.4µs, T0L=0.85µs (16 ticks, 34 ticks at 40MHz)
-                    rmtItems[itemIndex].duration0 = 16;                                                             // 0.4µs
-                    rmtItems[itemIndex].level1 = 0;
-                    rmtItems[itemIndex].duration1 = 34;                                                             // 0.85µs
-                }
-                itemIndex++;
-            }
+    if (!isOn) {                                                                                                    // Off frame is encoded once and then reused as is
+        if (offFrameReady) return;
+        for (itemIndex = 0; itemIndex < (uint32_t)maxPixel * 24; itemIndex++) {
+            rmtItems[itemIndex] = bitItems[0];
         }
+        offFrameReady = true;
+    } else {
+        encodeFrame(itemIndex);                                                                                     // Convert pixel data to RMT items
+        offFrameReady = false;
     }
-    
-    /*
-        Add reset pulse (>50µs low) - WS2812B needs this to latch data properly
-        At 40MHz, 50µs = 2000 ticks, but RMT max duration is 32767 ticks
-        So we'll add reset pulse to achieve >50µs total
-    */
-    rmtItems[itemIndex].level0 = 0;
-    rmtItems[itemIndex].duration0 = 2000;                                                                           // 50µs low
-    rmtItems[itemIndex].level1 = 0;
-    rmtItems[itemIndex].duration1 = 0;
+}
+
+HMS_StatusLED_EncodedSlot* HMS_StatusLED::encodedData() {
+    return rmtItems;
+}
+
+uint32_t HMS_StatusLED::encodedLength() const {
+    return (uint32_t)maxPixel * 24;                                                                                 // The reset is the idle level after the items
+}
+
+void HMS_StatusLED::waitForTransfer() {
+    if (lastFrameEnd == 0) return;                                                                                  // Nothing sent yet
+    rmt_wait_tx_done(rmtChannel, portMAX_DELAY);
+    while (esp_timer_get_time() < lastFrameEnd + timing.resetUs);                                                  // Only the remainder of the latch time is waited out
+}
+
+HMS_StatusLED_StatusTypeDef HMS_StatusLED::transmit(const HMS_StatusLED_EncodedSlot *data, uint32_t length) {
+    waitForTransfer();
+    lastFrameEnd = esp_timer_get_time() + ((int64_t)length * timing.bitNs) / 1000;
+    esp_err_t result = rmt_write_items(rmtChannel, data, length, false);                                            // Send data via RMT, returns once the items are queued
+    if (result != ESP_OK) {
+        HMS_STATUSLED_LOG_ERROR("RMT transmission failed");
+        return HMS_STATUSLED_ERROR;
+    }
+
+    return HMS_STATUSLED_OK;
 }
 
 HMS_StatusLED_StatusTypeDef HMS_StatusLED::show() {
+    waitForTransfer();                                                                                              // The RMT ISR may still be reading the items
     updateRMTBuffer();                                                                                              // Update RMT buffer with current pixel data
     
-    esp_err_t result = rmt_write_items(rmtChannel, rmtItems, maxPixel * 24 + 1, true);                            // Send data via RMT (+1 for reset pulse)
-    if (result != ESP_OK) {
-        #ifdef HMS_STATUSLED_LOGGER_ENABLED
-            statusLEDLogger.debug("Error: RMT transmission failed");
-        #endif
+    if (transmit(rmtItems, encodedLength()) != HMS_STATUSLED_OK) {                                                 // Send data via RMT
         return HMS_STATUSLED_ERROR;
     }
     
-    #ifdef HMS_STATUSLED_LOGGER_ENABLED
-        statusLEDLogger.debug("LED data sent via RMT");
-    #endif
+    HMS_STATUSLED_TRACE(HMS_STATUSLED_TRACE_SHOW, 0, encodedLength());
     
     return HMS_STATUSLED_OK;
 }
 
+#elif defined(HMS_STATUSLED_PLATFORM_ARDUINO_ESP32) || defined(HMS_STATUSLED_PLATFORM_ESP_IDF)
+#define HMS_STATUSLED_NS_TO_RMT_TICKS(NS)  ((uint16_t)(((uint64_t)(NS) * HMS_STATUSLED_RMT_RESOLUTION_HZ + 500000000ULL) / 1000000000ULL))
 
-#elif defined(HMS_STATUSLED_PLATFORM_ZEPHYR)
-#elif defined(HMS_STATUSLED_PLATFORM_STM32_HAL)
-void HMS_StatusLED::updateDMABuffer() {
-    uint32_t bufferIndex = 0;
-    
-    for (uint16_t i = 0; i < maxPixel; i++) {                                                                       // Convert pixel data to PWM duty cycles for DMA
-        for (uint8_t colorComponent = 0; colorComponent < 3; colorComponent++) {
-            uint8_t colorValue = pixel[i][colorComponent];
+HMS_StatusLED_StatusTypeDef HMS_StatusLED::begin(uint8_t pin) {
+    outputPin = pin;
 
-            for (int8_t bit = 7; bit >= 0; bit--) {                                                                 // Convert each bit of the color value to PWM duty cycle
-                if (colorValue & (1 << bit)) {
-                    buffer[bufferIndex] = pulse1;                                                                   // High bit (T1H)
-                } else {
-                    buffer[bufferIndex] = pulse0;                                                                   // Low bit (T0H)
-                }
-                bufferIndex++;
-            }
-        }
-    }
-    
-    for (uint16_t i = 0; i < 50; i++) {                                                                             // Add reset pulse (50µs of low) - WS2812B needs >50µs reset time
-        if (bufferIndex < buffer.size()) {
-            buffer[bufferIndex++] = 0;
-        }
-    }
-}
+    rmt_tx_channel_config_t channelConfig = {};
+    channelConfig.gpio_num          = (gpio_num_t)pin;
+    channelConfig.clk_src           = RMT_CLK_SRC_DEFAULT;
+    channelConfig.resolution_hz     = HMS_STATUSLED_RMT_RESOLUTION_HZ;
+    channelConfig.mem_block_symbols = HMS_STATUSLED_RMT_MEM_BLOCK_SYMBOLS;
+    channelConfig.trans_queue_depth = 1;                                                                            // One frame in flight, show() waits for the previous one
+    channelConfig.flags.with_dma    = HMS_STATUSLED_RMT_WITH_DMA;
+    channelConfig.flags.invert_out  = timing.inverted;                                                              // Symbols keep their levels, the GPIO matrix inverts them
 
-HMS_StatusLED_StatusTypeDef HMS_StatusLED::show() {
-    if (!statusLED_hTim) {
-        #ifdef HMS_STATUSLED_LOGGER_ENABLED
-          statusLEDLogger.debug("Error: Timer not initialized. Call begin() first.");
-        #endif
-        return HMS_STATUSLED_ERROR;
+    esp_err_t result = rmt_new_tx_channel(&channelConfig, &rmtChannel);
+    if (result != ESP_OK && channelConfig.flags.with_dma) {                                                         // Only some targets have an RMT DMA, retry with the channel memory
+        channelConfig.flags.with_dma    = false;
+        channelConfig.mem_block_symbols = 64;
+        result = rmt_new_tx_channel(&channelConfig, &rmtChannel);
     }
-    
-    updateDMABuffer();                                                                                              // Update DMA buffer with current pixel data
-    
-    HAL_StatusTypeDef halStatus = HAL_TIM_PWM_Start_DMA(                                                            // Start DMA transfer
-        statusLED_hTim, 
-        timerChannel, 
-        (uint32_t*)buffer.data(), 
-        buffer.size()
-    );
-    
-    if (halStatus != HAL_OK) {
-        #ifdef HMS_STATUSLED_LOGGER_ENABLED
-          statusLEDLogger.debug("Error: Failed to start DMA transfer");
-        #endif
+    if (result != ESP_OK) {
+        HMS_STATUSLED_LOG_ERROR("RMT TX channel creation failed");
         return HMS_STATUSLED_ERROR;
     }
-    
-    #ifdef HMS_STATUSLED_LOGGER_ENABLED
-      statusLEDLogger.debug("LED data sent via DMA");
-    #endif
-    
-    return HMS_STATUSLED_OK;
-}
 
-HMS_StatusLED_StatusTypeDef HMS_StatusLED::begin(TIM_HandleTypeDef *hTim, uint16_t timerBusFrequencyMHz, uint8_t channel) {
-    if(!hTim) {
-        #ifdef HMS_STATUSLED_LOGGER_ENABLED
-          statusLEDLogger.debug("Error: Invalid Timer Handle");
-        #endif
+    rmt_bytes_encoder_config_t encoderConfig = {};                                                                  // Bit symbols of the WS2812 waveform, the encoder expands every byte MSB first
+    encoderConfig.bit0.level0    = 1;
+    encoderConfig.bit0.duration0 = HMS_STATUSLED_NS_TO_RMT_TICKS(timing.t0hNs);
+    encoderConfig.bit0.level1    = 0;
+    encoderConfig.bit0.duration1 = HMS_STATUSLED_NS_TO_RMT_TICKS(timing.bitNs - timing.t0hNs);
+    encoderConfig.bit1.level0    = 1;
+    encoderConfig.bit1.duration0 = HMS_STATUSLED_NS_TO_RMT_TICKS(timing.t1hNs);
+    encoderConfig.bit1.level1    = 0;
+    encoderConfig.bit1.duration1 = HMS_STATUSLED_NS_TO_RMT_TICKS(timing.bitNs - timing.t1hNs);
+    encoderConfig.flags.msb_first = 1;
+
+    result = rmt_new_bytes_encoder(&encoderConfig, &bytesEncoder);
+    if (result != ESP_OK) {
+        HMS_STATUSLED_LOG_ERROR("RMT bytes encoder creation failed");
         return HMS_STATUSLED_ERROR;
     }
 
-    if(channel != TIM_CHANNEL_1 && channel != TIM_CHANNEL_2 &&                                                      // Validate channel (STM32 HAL uses TIM_CHANNEL_x constants)
-       channel != TIM_CHANNEL_3 && channel != TIM_CHANNEL_4) {
-        #ifdef HMS_STATUSLED_LOGGER_ENABLED
-          statusLEDLogger.debug("Error: Invalid Timer Channel");
-        #endif
+    transferDone = xSemaphoreCreateBinary();
+    xSemaphoreGive(transferDone);                                                                                   // Channel starts idle
+
+    rmt_tx_event_callbacks_t callbacks = {};
+    callbacks.on_trans_done = onTransferDone;
+    rmt_tx_register_event_callbacks(rmtChannel, &callbacks, this);
+
+    result = rmt_enable(rmtChannel);
+    if (result != ESP_OK) {
+        HMS_STATUSLED_LOG_ERROR("RMT channel enable failed");
         return HMS_STATUSLED_ERROR;
     }
 
-    statusLED_hTim = hTim;
-    timerChannel = channel;
+    clear();                                                                                                        // Clear pixels
 
-    float timerFrequencyMHz = (float)timerBusFrequencyMHz;                                                          // Calculate timer values based on frequency and WS2812B timing requirements
-    autoReloadValue = (uint32_t)((timerFrequencyMHz * HMS_STATUSLED_PULSE_LENGTH_NS) / 1000.0f) - 1;                // WS2812B timing: T0H=0.4µs, T0L=0.85µs, T1H=0.8µs, T1L=0.45µs, Period=1.25µs
-    
-    pulse0 = (uint16_t)((timerFrequencyMHz * HMS_STATUSLED_PULSE_0_NS) / 1000.0f);                                  // Calculate pulse widths
-    pulse1 = (uint16_t)((timerFrequencyMHz * HMS_STATUSLED_PULSE_1_NS) / 1000.0f);
+    HMS_STATUSLED_LOG_INFO("ESP32 RMT TX Driver Started on pin %d (DMA %s)", pin, channelConfig.flags.with_dma ? "on" : "off");
 
-    __HAL_TIM_SET_AUTORELOAD(hTim, autoReloadValue);                                                                // Configure timer
-    __HAL_TIM_SET_PRESCALER(hTim, 0);
+    return HMS_STATUSLED_OK;
+}
 
-    std::fill(buffer.begin(), buffer.end(), 0);                                                                     // Clear buffers
-    for(auto& pixelData : pixel) {
-        std::fill(pixelData.begin(), pixelData.end(), 0);
+void HMS_StatusLED::encodeByte(uint8_t colorValue, HMS_StatusLED_EncodedSlot *slots) {
+    *slots = colorValue;                                                                                            // Bits are expanded to RMT symbols by the bytes encoder
+}
+
+void HMS_StatusLED::updateRMTBuffer() {
+    if (!isOn) {                                                                                                    // Off frame is encoded once and then reused as is
+        if (offFrameReady) return;
+        std::fill(buffer.begin(), buffer.end(), 0);
+        offFrameReady = true;
+    } else {
+        uint32_t bufferIndex = 0;
+        encodeFrame(bufferIndex);
+        offFrameReady = false;
     }
+}
 
-    updateDMABuffer();                                                                                              // Initialize DMA buffer with reset values (low for reset pulse)
+HMS_StatusLED_EncodedSlot* HMS_StatusLED::encodedData() {
+    return buffer.data();
+}
 
-    #ifdef HMS_STATUSLED_LOGGER_ENABLED
-      statusLEDLogger.debug("Timer configured: ARR=%lu, Pulse0=%d, Pulse1=%d", autoReloadValue, pulse0, pulse1);
-      statusLEDLogger.debug("HMS_StatusLED Driver Started");
-    #endif
+uint32_t HMS_StatusLED::encodedLength() const {
+    return buffer.size();
+}
 
-    return HMS_STATUSLED_OK;
+bool IRAM_ATTR HMS_StatusLED::onTransferDone(rmt_channel_handle_t channel, const rmt_tx_done_event_data_t *event, void *userData) {
+    (void)channel;
+    (void)event;
+    HMS_StatusLED *self = static_cast<HMS_StatusLED*>(userData);                                                    // Runs in the RMT ISR context
+    BaseType_t    taskWoken = pdFALSE;
+
+    self->lastFrameEnd = esp_timer_get_time();
+    xSemaphoreGiveFromISR(self->transferDone, &taskWoken);
+    return taskWoken == pdTRUE;
 }
-#endif 
 
-HMS_StatusLED_StatusTypeDef HMS_StatusLED::setPixelColor(uint32_t color, uint16_t pixelIndex) {
-    return setPixelColor(color, pixelIndex, colorOrder);
+void HMS_StatusLED::waitForTransfer() {
+    if (!transferDone) return;
+    xSemaphoreTake(transferDone, portMAX_DELAY);
+    xSemaphoreGive(transferDone);
+    while (esp_timer_get_time() - lastFrameEnd < timing.resetUs);                                                  // Only the remainder of the latch time is waited out
 }
 
-HMS_StatusLED_StatusTypeDef HMS_StatusLED::setPixelColor(uint32_t color, uint16_t pixelIndex, HMS_StatusLED_OrderType colorOrder) {
-    if (pixelIndex >= maxPixel) {                                                                                   // Validate pixel index
-        #ifdef HMS_STATUSLED_LOGGER_ENABLED
-          statusLEDLogger.debug("Error: Pixel index out of range");
-        #endif
+HMS_StatusLED_StatusTypeDef HMS_StatusLED::transmit(const HMS_StatusLED_EncodedSlot *data, uint32_t length) {
+    if (!rmtChannel) {
+        HMS_STATUSLED_LOG_ERROR("RMT not initialized. Call begin() first.");
         return HMS_STATUSLED_ERROR;
     }
 
-    uint8_t r, g, b;                                                                                                // Auto-detect color format based on value range
+    xSemaphoreTake(transferDone, portMAX_DELAY);                                                                    // Channel is owned until onTransferDone()
+    while (esp_timer_get_time() - lastFrameEnd < timing.resetUs);
 
-    if (color <= 0xFFFF) {                                                                                          // Detected format RGB565: max value is 0xFFFF (65535)    
-        r = HMS_STATUSLED_GET_RED_565(color);
-        g = HMS_STATUSLED_GET_GREEN_565(color);
-        b = HMS_STATUSLED_GET_BLUE_565(color);
-        
-        #ifdef HMS_STATUSLED_LOGGER_ENABLED
-          statusLEDLogger.debug("RGB565 color detected");
-        #endif
-    } else {                                                                                                        // Detected format RGB888: max value is 0xFFFFFF (16777215)
-        r = HMS_STATUSLED_GET_RED_888(color);
-        g = HMS_STATUSLED_GET_GREEN_888(color);
-        b = HMS_STATUSLED_GET_BLUE_888(color);
-        
-        #ifdef HMS_STATUSLED_LOGGER_ENABLED
-          statusLEDLogger.debug("RGB888 color detected");
-        #endif
+    rmt_transmit_config_t transmitConfig = {};
+    transmitConfig.loop_count = 0;
+
+    esp_err_t result = rmt_transmit(rmtChannel, bytesEncoder, data, length, &transmitConfig);                      // Returns as soon as the frame is queued
+    if (result != ESP_OK) {
+        xSemaphoreGive(transferDone);
+        HMS_STATUSLED_LOG_ERROR("RMT transmission failed");
+        return HMS_STATUSLED_ERROR;
     }
-    
-    #if (HMS_STATUSLED_GAMMA == true)                                                                               // Apply gamma correction if enabled
-        r = gammaLut[r];    g = gammaLut[g];    b = gammaLut[b];
-    #endif
 
-    // Store original colors (before brightness scaling)
-    uint8_t originalR = r, originalG = g, originalB = b;
+    return HMS_STATUSLED_OK;
+}
 
-    // Apply brightness scaling (0-255)
-    r = (r * brightness) / 255;
-    g = (g * brightness) / 255;
-    b = (b * brightness) / 255;
+HMS_StatusLED_StatusTypeDef HMS_StatusLED::show() {
+    waitForTransfer();                                                                                              // The encoder must not overwrite a frame still being streamed
+    updateRMTBuffer();
 
-    // Store original values for brightness changes later
-    switch (colorOrder) {
-        case HMS_STATUSLED_ORDER_RGB:
-            originalPixel[pixelIndex][0] = originalR;   originalPixel[pixelIndex][1] = originalG;   originalPixel[pixelIndex][2] = originalB;   break;  
-        case HMS_STATUSLED_ORDER_BGR:
-            originalPixel[pixelIndex][0] = originalB;   originalPixel[pixelIndex][1] = originalG;   originalPixel[pixelIndex][2] = originalR;   break;    
-        case HMS_STATUSLED_ORDER_GRB:
-            originalPixel[pixelIndex][0] = originalG;   originalPixel[pixelIndex][1] = originalR;   originalPixel[pixelIndex][2] = originalB;   break;    
-        default:
-            originalPixel[pixelIndex][0] = originalR;   originalPixel[pixelIndex][1] = originalG;   originalPixel[pixelIndex][2] = originalB;   break;
+    if (transmit(buffer.data(), buffer.size()) != HMS_STATUSLED_OK) {
+        return HMS_STATUSLED_ERROR;
     }
 
-    switch (colorOrder) {                                                                                           // Load pixel vector according to selected color order
-        case HMS_STATUSLED_ORDER_RGB:
-            pixel[pixelIndex][0] = r;   pixel[pixelIndex][1] = g;   pixel[pixelIndex][2] = b;   break;  
-        case HMS_STATUSLED_ORDER_BGR:
-            pixel[pixelIndex][0] = b;   pixel[pixelIndex][1] = g;   pixel[pixelIndex][2] = r;   break;    
-        case HMS_STATUSLED_ORDER_GRB:
-            pixel[pixelIndex][0] = g;   pixel[pixelIndex][1] = r;   pixel[pixelIndex][2] = b;   break;    
-        default:
-            pixel[pixelIndex][0] = r;   pixel[pixelIndex][1] = g;   pixel[pixelIndex][2] = b;   break;              // Default to RGB order
+    HMS_STATUSLED_TRACE(HMS_STATUSLED_TRACE_SHOW, 0, encodedLength());
+
+    return HMS_STATUSLED_OK;
+}
+
+
+#elif defined(HMS_STATUSLED_PLATFORM_ZEPHYR)
+HMS_StatusLED_StatusTypeDef HMS_StatusLED::begin(const struct device *spi) {
+    if (!spi || !device_is_ready(spi)) {
+        HMS_STATUSLED_LOG_ERROR("SPI device not ready");
+        return HMS_STATUSLED_ERROR;
+    }
+
+    spiDevice = spi;
+
+    spiConfig.frequency = getSPIPatterns(timing, pulse0, pulse1);
+    spiConfig.operation = SPI_OP_MODE_MASTER | SPI_TRANSFER_MSB | SPI_WORD_SET(8);
+    spiConfig.slave     = 0;
+
+    clear();
+    updateSPIBuffer();
+
+    HMS_STATUSLED_LOG_DEBUG("SPI configured: %lu Hz, Pulse0=0x%02X, Pulse1=0x%02X", (unsigned long)spiConfig.frequency, pulse0, pulse1);
+    HMS_STATUSLED_LOG_INFO("HMS_StatusLED Driver Started");
+
+    return HMS_STATUSLED_OK;
+}
+
+void HMS_StatusLED::encodeByte(uint8_t colorValue, HMS_StatusLED_EncodedSlot *slots) {
+    for (int8_t bit = 7; bit >= 0; bit--) {                                                                         // Convert each bit of the color value to an SPI byte pattern
+        *slots++ = (colorValue & (1 << bit)) ? pulse1 : pulse0;
+    }
+}
+
+void HMS_StatusLED::updateSPIBuffer() {
+    if (!isOn) {                                                                                                    // Off frame is encoded once and then reused as is
+        if (offFrameReady) return;
+        std::fill(buffer.begin(), buffer.end(), pulse0);
+        offFrameReady = true;
+    } else {
+        uint32_t bufferIndex = 0;
+        encodeFrame(bufferIndex);                                                                                   // Convert pixel data to SPI byte patterns
+        offFrameReady = false;
+    }
+}
+
+HMS_StatusLED_EncodedSlot* HMS_StatusLED::encodedData() {
+    return buffer.data();
+}
+
+uint32_t HMS_StatusLED::encodedLength() const {
+    return buffer.size();
+}
+
+void HMS_StatusLED::onTransferDone(const struct device *dev, int result, void *userData) {
+    (void)dev;
+    (void)result;
+    k_sem_give(&static_cast<HMS_StatusLED*>(userData)->transferDone);                                               // Runs in the SPI ISR context
+}
+
+void HMS_StatusLED::waitForTransfer() {
+    if (!spiDevice) return;
+    k_sem_take(&transferDone, K_FOREVER);
+    k_sem_give(&transferDone);
+    while ((uint32_t)(k_cycle_get_32() - frameStart) < frameHold);                                                  // Only the remainder of the latch time is waited out
+}
+
+HMS_StatusLED_StatusTypeDef HMS_StatusLED::transmit(const HMS_StatusLED_EncodedSlot *data, uint32_t length) {
+    if (!spiDevice) {
+        HMS_STATUSLED_LOG_ERROR("SPI not initialized. Call begin() first.");
+        return HMS_STATUSLED_ERROR;
     }
 
-    #ifdef HMS_STATUSLED_LOGGER_ENABLED
-        statusLEDLogger.debug("Pixel %d set to R:%d G:%d B:%d (Order: %d)", pixelIndex, r, g, b, colorOrder);
+    struct spi_buf     txBuffer;
+    struct spi_buf_set txBufferSet;
+    txBuffer.buf       = (void*)data;
+    txBuffer.len       = length;
+    txBufferSet.buffers = &txBuffer;
+    txBufferSet.count   = 1;
+
+    k_sem_take(&transferDone, K_FOREVER);                                                                           // Bus is owned until onTransferDone()
+    while ((uint32_t)(k_cycle_get_32() - frameStart) < frameHold);                                                  // Latch gap of the previous frame, the data pins idle at their last (low) bit
+
+    frameStart = k_cycle_get_32();
+    frameHold  = k_us_to_cyc_ceil32((uint32_t)(((uint64_t)length * 8000000) / spiConfig.frequency) + timing.resetUs);  // One SPI byte per LED bit
+
+    #if defined(CONFIG_SPI_ASYNC)
+        int result = spi_transceive_cb(spiDevice, &spiConfig, &txBufferSet, NULL, onTransferDone, this);           // Returns as soon as the transfer is queued
+    #else
+        int result = spi_write(spiDevice, &spiConfig, &txBufferSet);
+        k_sem_give(&transferDone);
     #endif
 
+    if (result != 0) {
+        #if defined(CONFIG_SPI_ASYNC)
+            k_sem_give(&transferDone);
+        #endif
+        HMS_STATUSLED_LOG_ERROR("SPI transfer failed (%d)", result);
+        return HMS_STATUSLED_ERROR;
+    }
+
     return HMS_STATUSLED_OK;
 }
 
-void HMS_StatusLED::setColorOrder(HMS_StatusLED_OrderType order) {
-    colorOrder = order;
+HMS_StatusLED_StatusTypeDef HMS_StatusLED::show() {
+    waitForTransfer();                                                                                              // The encoder must not overwrite a frame still on the bus
+    updateSPIBuffer();
+
+    if (transmit(buffer.data(), buffer.size()) != HMS_STATUSLED_OK) {
+        return HMS_STATUSLED_ERROR;
+    }
+
+    HMS_STATUSLED_TRACE(HMS_STATUSLED_TRACE_SHOW, 0, encodedLength());
+
+    return HMS_STATUSLED_OK;
+}
+#elif defined(HMS_STATUSLED_PLATFORM_STM32_HAL)
+void HMS_StatusLED::encodeByte(uint8_t colorValue, HMS_StatusLED_EncodedSlot *slots) {
+    for (int8_t bit = 7; bit >= 0; bit--) {                                                                         // Convert each bit of the color value to PWM duty cycle
+        if (colorValue & (1 << bit)) {
+            *slots++ = pulse1;                                                                                      // High bit (T1H)
+        } else {
+            *slots++ = pulse0;                                                                                      // Low bit (T0H)
+        }
+    }
+}
+
+void HMS_StatusLED::updateDMABuffer() {
+    uint32_t bufferIndex = (uint32_t)maxPixel * 24;
+    if (!isOn) {                                                                                                    // Off frame is encoded once and then reused as is
+        if (offFrameReady) return;
+        std::fill(buffer.begin(), buffer.begin() + bufferIndex, (uint8_t)pulse0);
+        offFrameReady = true;
+    } else {
+        bufferIndex = 0;
+        encodeFrame(bufferIndex);                                                                                   // Convert pixel data to PWM duty cycles for DMA
+        offFrameReady = false;
+    }
     
-    #ifdef HMS_STATUSLED_LOGGER_ENABLED
-      char logMessage[50];
-      sprintf(logMessage, "Color order set to: %d", order);
-      statusLEDLogger.debug(logMessage);
-    #endif
+    std::fill(buffer.begin() + bufferIndex, buffer.end(), 0);                                                       // Idle slots, the latch itself is the timed gap in waitForTransfer()
 }
 
-void HMS_StatusLED::clear() {
-    for (auto& pixelData : pixel) {                                                                                // Clear all pixel data
-        std::fill(pixelData.begin(), pixelData.end(), 0);
+HMS_StatusLED_EncodedSlot* HMS_StatusLED::encodedData() {
+    return buffer.data();
+}
+
+uint32_t HMS_StatusLED::encodedLength() const {
+    return buffer.size();
+}
+
+void HMS_StatusLED::waitForTransfer() {
+    while ((uint32_t)(HMS_STATUSLED_LATCH_CLOCK() - frameStart) < frameHold);                                       // DMA transfer plus the remainder of the latch time
+}
+
+HMS_StatusLED_StatusTypeDef HMS_StatusLED::transmit(const HMS_StatusLED_EncodedSlot *data, uint32_t length) {
+    if (!statusLED_hTim) {
+        HMS_STATUSLED_LOG_ERROR("Timer not initialized. Call begin() first.");
+        return HMS_STATUSLED_ERROR;
     }
-    for (auto& pixelData : originalPixel) {                                                                        // Clear original pixel data too
-        std::fill(pixelData.begin(), pixelData.end(), 0);
+
+    waitForTransfer();
+    frameStart = HMS_STATUSLED_LATCH_CLOCK();
+    frameHold  = HMS_STATUSLED_US_TO_LATCH((length * timing.bitNs) / 1000 + timing.resetUs);
+
+    HAL_StatusTypeDef halStatus = HAL_TIM_PWM_Start_DMA(                                                            // Start DMA transfer
+        statusLED_hTim, 
+        timerChannel, 
+        (uint32_t*)data, 
+        length
+    );
+    
+    if (halStatus != HAL_OK) {
+        HMS_STATUSLED_LOG_ERROR("Failed to start DMA transfer");
+        return HMS_STATUSLED_ERROR;
     }
+
+    return HMS_STATUSLED_OK;
+}
+
+HMS_StatusLED_StatusTypeDef HMS_StatusLED::show() {
+    if (!statusLED_hTim) {
+        HMS_STATUSLED_LOG_ERROR("Timer not initialized. Call begin() first.");
+        return HMS_STATUSLED_ERROR;
+    }
+    
+    waitForTransfer();                                                                                              // DMA may still be reading the previous frame
+    updateDMABuffer();                                                                                              // Update DMA buffer with current pixel data
+    
+    if (transmit(buffer.data(), buffer.size()) != HMS_STATUSLED_OK) {
+        return HMS_STATUSLED_ERROR;
+    }
+    
+    HMS_STATUSLED_TRACE(HMS_STATUSLED_TRACE_SHOW, 0, encodedLength());
+    
+    return HMS_STATUSLED_OK;
+}
+
+HMS_StatusLED_StatusTypeDef HMS_StatusLED::begin(TIM_HandleTypeDef *hTim, uint16_t timerBusFrequencyMHz, uint8_t channel) {
+    if(!hTim) {
+        HMS_STATUSLED_LOG_ERROR("Invalid Timer Handle");
+        return HMS_STATUSLED_ERROR;
+    }
+
+    if(channel != TIM_CHANNEL_1 && channel != TIM_CHANNEL_2 &&                                                      // Validate channel (STM32 HAL uses TIM_CHANNEL_x constants)
+       channel != TIM_CHANNEL_3 && channel != TIM_CHANNEL_4) {
+        HMS_STATUSLED_LOG_ERROR("Invalid Timer Channel");
+        return HMS_STATUSLED_ERROR;
+    }
+
+    statusLED_hTim = hTim;
+    timerChannel = channel;
+
+    float timerFrequencyMHz = (float)timerBusFrequencyMHz;                                                          // Calculate timer values based on frequency and WS2812B timing requirements
+    autoReloadValue = (uint32_t)((timerFrequencyMHz * timing.bitNs) / 1000.0f) - 1;                                  // Period of one bit of the timing profile
     
-    #ifdef HMS_STATUSLED_LOGGER_ENABLED
-      statusLEDLogger.debug("All pixels cleared");
+    pulse0 = (uint16_t)((timerFrequencyMHz * timing.t0hNs) / 1000.0f);                                              // Calculate pulse widths
+    pulse1 = (uint16_t)((timerFrequencyMHz * timing.t1hNs) / 1000.0f);
+
+    __HAL_TIM_SET_AUTORELOAD(hTim, autoReloadValue);                                                                // Configure timer
+    __HAL_TIM_SET_PRESCALER(hTim, 0);
+
+    #if defined(DWT)
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;                                                             // Cycle counter times the latch gap
+        DWT->CTRL        |= DWT_CTRL_CYCCNTENA_Msk;
     #endif
+    if (timing.inverted) {
+        hTim->Instance->CCER |= (TIM_CCER_CC1P << channel);                                                        // Active low output, a 0% duty cycle idles high
+    } else {
+        hTim->Instance->CCER &= ~(TIM_CCER_CC1P << channel);
+    }
+
+    std::fill(buffer.begin(), buffer.end(), 0);                                                                     // Clear buffers
+    for(auto& pixelData : pixel) {
+        std::fill(pixelData.begin(), pixelData.end(), 0);
+    }
+
+    updateDMABuffer();                                                                                              // Initialize DMA buffer with idle values (0% duty cycle)
+
+    HMS_STATUSLED_LOG_DEBUG("Timer configured: ARR=%lu, Pulse0=%d, Pulse1=%d", (unsigned long)autoReloadValue, pulse0, pulse1);
+    HMS_STATUSLED_LOG_INFO("HMS_StatusLED Driver Started");
+
+    return HMS_STATUSLED_OK;
+}
+#elif defined(HMS_STATUSLED_PLATFORM_HOST)
+/*
+    Host backend for desktop builds (define HMS_STATUSLED_HOST). It runs the shared encoder exactly like the
+    STM32 HAL backend, against a simulated PWM timer: every slot is a compare value, one timer period per bit.
+    transmit() captures the frame and advances a simulated clock instead of driving a pin, so the captured
+    stream can be checked with HMS_StatusLED_WireDecoder (HMS_StatusLED_Verify.h).
+*/
+HMS_StatusLED_StatusTypeDef HMS_StatusLED::begin(uint16_t timerFrequencyMHz) {
+    uint32_t period = ((uint32_t)timerFrequencyMHz * timing.bitNs) / 1000;                                          // Same rounding as the STM32 HAL backend
+    if (period < 2 || period > 256) {                                                                               // Compare values are stored in one byte
+        HMS_STATUSLED_LOG_ERROR("Timer frequency does not fit the bit time");
+        return HMS_STATUSLED_ERROR;
+    }
+
+    this->timerFrequencyMHz = timerFrequencyMHz;
+    autoReloadValue = period - 1;
+    pulse0 = (uint8_t)(((uint32_t)timerFrequencyMHz * timing.t0hNs) / 1000);
+    pulse1 = (uint8_t)(((uint32_t)timerFrequencyMHz * timing.t1hNs) / 1000);
+
+    simulatedTimeNs = 0;
+    capturedFrame.clear();
+    clear();
+    updateDMABuffer();
+
+    HMS_STATUSLED_LOG_INFO("HMS_StatusLED host Driver Started (%u MHz timer)", timerFrequencyMHz);
+
+    return HMS_STATUSLED_OK;
 }
 
-void HMS_StatusLED::turnOff() {
-    if (isOn) {
-        // Save current original state before turning off
-        for (uint16_t i = 0; i < maxPixel; i++) {
-            for (uint8_t j = 0; j < 3; j++) {
-                lastState[i][j] = originalPixel[i][j];
-            }
-        }
-        
-        // Clear all pixels (both display and original)
-        clear();
-        for (auto& pixelData : originalPixel) {
-            std::fill(pixelData.begin(), pixelData.end(), 0);
-        }
-        
-        isOn = false;
-        
-        #ifdef HMS_STATUSLED_LOGGER_ENABLED
-          statusLEDLogger.debug("LEDs turned off, state saved");
-        #endif
+void HMS_StatusLED::encodeByte(uint8_t colorValue, HMS_StatusLED_EncodedSlot *slots) {
+    for (int8_t bit = 7; bit >= 0; bit--) {
+        *slots++ = (colorValue & (1 << bit)) ? pulse1 : pulse0;
     }
 }
 
-void HMS_StatusLED::turnOn() {
+void HMS_StatusLED::updateDMABuffer() {
+    uint32_t bufferIndex = (uint32_t)maxPixel * 24;
     if (!isOn) {
-        // Restore last saved state to original pixels
-        for (uint16_t i = 0; i < maxPixel; i++) {
-            for (uint8_t j = 0; j < 3; j++) {
-                originalPixel[i][j] = lastState[i][j];
-            }
+        if (offFrameReady) return;
+        std::fill(buffer.begin(), buffer.begin() + bufferIndex, pulse0);
+        offFrameReady = true;
+    } else {
+        bufferIndex = 0;
+        encodeFrame(bufferIndex);
+        offFrameReady = false;
+    }
+
+    std::fill(buffer.begin() + bufferIndex, buffer.end(), 0);
+}
+
+HMS_StatusLED_EncodedSlot* HMS_StatusLED::encodedData() {
+    return buffer.data();
+}
+
+uint32_t HMS_StatusLED::encodedLength() const {
+    return buffer.size();
+}
+
+void HMS_StatusLED::waitForTransfer() {                                                                            // Transfers complete instantly, their time is only accounted in simulatedTimeNs
+}
+
+HMS_StatusLED_StatusTypeDef HMS_StatusLED::transmit(const HMS_StatusLED_EncodedSlot *data, uint32_t length) {
+    if (timerFrequencyMHz == 0) {
+        HMS_STATUSLED_LOG_ERROR("Timer not initialized. Call begin() first.");
+        return HMS_STATUSLED_ERROR;
+    }
+
+    capturedFrame.assign(data, data + length);
+    simulatedTimeNs += ((uint64_t)length * (autoReloadValue + 1) * 1000) / timerFrequencyMHz + timing.resetUs * 1000ULL;
+
+    return HMS_STATUSLED_OK;
+}
+
+HMS_StatusLED_StatusTypeDef HMS_StatusLED::show() {
+    updateDMABuffer();
+
+    if (transmit(buffer.data(), buffer.size()) != HMS_STATUSLED_OK) {
+        return HMS_STATUSLED_ERROR;
+    }
+
+    HMS_STATUSLED_TRACE(HMS_STATUSLED_TRACE_SHOW, 0, encodedLength());
+
+    return HMS_STATUSLED_OK;
+}
+#endif 
+
+#if defined(HMS_STATUSLED_HAS_ENCODER)
+void HMS_StatusLED::encodeFrame(uint32_t &index) {
+    ditherChannels.clear();                                                                                         // Rebuilt by encodeRange() in HDR mode, capacity is kept
+
+    if (paletteBits) {
+        encodeIndexedFrame(index);
+        encodeAll = true;
+        return;
+    }
+
+    uint8_t  stripMap[3];
+    getChannelMap(colorOrder, stripMap);
+    uint16_t powerScale = calculatePowerScale(channelSum);                                                                    // Scale output so the estimated draw stays within the power budget
+    uint16_t pixelIdx   = 0;
+    updateByteTable(powerScale);
+
+    if (!encodeAll && !offFrameReady && !hdrMode && !ringOffset && segments.empty() && powerScale == encodedPowerScale) {          // The live buffer holds the last frame, only written pixels change
+        index = (uint32_t)encodeStart * HMS_STATUSLED_SLOTS_PER_PIXEL;
+        encodeRange(encodeStart, encodeEnd - encodeStart, powerScale, stripMap, HMS_STATUSLED_SEGMENT_NORMAL, index);
+        index = (uint32_t)maxPixel * HMS_STATUSLED_SLOTS_PER_PIXEL;
+        encodeStart = encodeEnd = 0;
+        return;
+    }
+
+    for (uint8_t segmentId : segmentOrder) {                                                                        // Segments are kept sorted by start, gaps use the strip defaults
+        const HMS_StatusLED_Segment& segment = segments[segmentId];
+        uint8_t  channelMap[3];
+        uint16_t segmentScale = segment.isOn ? (powerScale * (segment.brightness + 1)) >> 8 : 0;
+
+        getChannelMap(segment.colorOrder, channelMap);
+        encodeRange(pixelIdx, segment.start - pixelIdx, powerScale, stripMap, HMS_STATUSLED_SEGMENT_NORMAL, index);
+        encodeRange(segment.start, segment.length, segmentScale, channelMap, segment.flags, index);
+        pixelIdx = segment.start + segment.length;
+    }
+
+    encodeRange(pixelIdx, maxPixel - pixelIdx, powerScale, stripMap, HMS_STATUSLED_SEGMENT_NORMAL, index);
+
+    encodeStart       = encodeEnd = 0;
+    encodeAll         = hdrMode || !segments.empty();                                                               // Segment and dithered frames are not plain pixel copies, the next one starts over
+    encodedPowerScale = powerScale;
+}
+
+void HMS_StatusLED::encodeRange(uint16_t start, uint16_t length, uint16_t scale, const uint8_t channelMap[3], uint8_t flags, uint32_t &index) {
+    uint16_t last     = start + length - 1;
+    uint32_t hdrScale = ((brightness16 + (brightness16 >> 15)) * (uint32_t)scale) >> 8;                            // 0-65536, full brightness is exact (HDR mode only)
+    HMS_StatusLED_EncodedSlot* output = encodedData() + index;
+    const HMS_StatusLED_EncodedSlot* table = (!byteTable.empty() && byteTableKey == (((uint32_t)brightness << 16) | scale)) ? byteTable.data() : nullptr;
+
+    for (uint16_t i = 0; i < length; i++) {
+        uint16_t offset = i;
+        if (flags & HMS_STATUSLED_SEGMENT_MIRRORED) {                                                               // Second half repeats the first half backwards
+            offset = (i < length - 1 - i) ? i : length - 1 - i;
         }
-        
-        // Apply current brightness to restored state
-        applyBrightnessToAllPixels();
-        
-        isOn = true;
-        
-        #ifdef HMS_STATUSLED_LOGGER_ENABLED
-          statusLEDLogger.debug("LEDs turned on, state restored");
-        #endif
+        uint16_t source = (flags & HMS_STATUSLED_SEGMENT_REVERSED) ? last - offset : start + offset;
+        if (ringOffset) {                                                                                           // Ring view: strip position -> stored pixel
+            uint32_t shifted = (uint32_t)source + ringOffset;
+            source = (shifted >= maxPixel) ? shifted - maxPixel : shifted;
+        }
+
+        if (hdrMode) {                                                                                              // Scaled from the stored channels, pixel[] only has 8-bit results
+            const std::vector<uint8_t>& data = originalPixel[source];
+            encodeDithered((data[channelMap[0]] * hdrScale) >> 8, source, output);
+            encodeDithered((data[channelMap[1]] * hdrScale) >> 8, source, output + HMS_STATUSLED_SLOTS_PER_CHANNEL);
+            encodeDithered((data[channelMap[2]] * hdrScale) >> 8, source, output + 2 * HMS_STATUSLED_SLOTS_PER_CHANNEL);
+        } else if (table) {                                                                                         // Brightness, power scale and bit expansion in one gather
+            const std::vector<uint8_t>& data = originalPixel[source];
+            const HMS_StatusLED_EncodedSlot* entry = table + data[channelMap[0]] * HMS_STATUSLED_SLOTS_PER_CHANNEL;
+            std::copy(entry, entry + HMS_STATUSLED_SLOTS_PER_CHANNEL, output);
+            entry = table + data[channelMap[1]] * HMS_STATUSLED_SLOTS_PER_CHANNEL;
+            std::copy(entry, entry + HMS_STATUSLED_SLOTS_PER_CHANNEL, output + HMS_STATUSLED_SLOTS_PER_CHANNEL);
+            entry = table + data[channelMap[2]] * HMS_STATUSLED_SLOTS_PER_CHANNEL;
+            std::copy(entry, entry + HMS_STATUSLED_SLOTS_PER_CHANNEL, output + 2 * HMS_STATUSLED_SLOTS_PER_CHANNEL);
+        } else if (!byteTable.empty()) {                                                                            // Table mode, other scale (dimmed segment): pixel[] is stale, same math as updateByteTable()
+            const std::vector<uint8_t>& data = originalPixel[source];
+            encodeByte((((data[channelMap[0]] * brightness) / 255) * scale) >> 8, output);
+            encodeByte((((data[channelMap[1]] * brightness) / 255) * scale) >> 8, output + HMS_STATUSLED_SLOTS_PER_CHANNEL);
+            encodeByte((((data[channelMap[2]] * brightness) / 255) * scale) >> 8, output + 2 * HMS_STATUSLED_SLOTS_PER_CHANNEL);
+        } else {
+            const std::vector<uint8_t>& data = pixel[source];
+            encodeByte((data[channelMap[0]] * scale) >> 8, output);
+            encodeByte((data[channelMap[1]] * scale) >> 8, output + HMS_STATUSLED_SLOTS_PER_CHANNEL);
+            encodeByte((data[channelMap[2]] * scale) >> 8, output + 2 * HMS_STATUSLED_SLOTS_PER_CHANNEL);
+        }
+        output += HMS_STATUSLED_SLOTS_PER_PIXEL;
     }
+    index += (uint32_t)length * HMS_STATUSLED_SLOTS_PER_PIXEL;
 }
 
-void HMS_StatusLED::setBrightness(uint8_t newBrightness) {
-    brightness = newBrightness;
-    
-    #ifdef HMS_STATUSLED_LOGGER_ENABLED
-      char logMessage[50];
-      sprintf(logMessage, "Brightness set to: %d", brightness);
-      statusLEDLogger.debug(logMessage);
+/*
+    Table mode: the stored channels already carry gamma, and brightness and the power scale are the same for
+    every pixel of the strip. So every stored value 0-255 has one final encoding per frame; byteTable holds it
+    for all 256 values and encodeRange() only gathers. A brightness change no longer touches the pixel plane
+    (pixel[] goes stale until table mode is left), the table is rebuilt on the next encode instead. Segments
+    with their own brightness and HDR mode keep the per channel path.
+*/
+void HMS_StatusLED::setTableEncodeMode(bool enabled) {
+    if (enabled) {
+        byteTable.resize(256 * HMS_STATUSLED_SLOTS_PER_CHANNEL);
+        byteTableKey = UINT32_MAX;                                                                                  // Built by the next encode
+    } else if (!byteTable.empty()) {
+        std::vector<HMS_StatusLED_EncodedSlot>().swap(byteTable);
+        applyBrightnessToAllPixels();                                                                               // Bring pixel[] back up to date
+    }
+}
+
+void HMS_StatusLED::updateByteTable(uint16_t scale) {
+    uint32_t key = ((uint32_t)brightness << 16) | scale;
+    if (byteTable.empty() || key == byteTableKey) return;
+
+    for (uint16_t value = 0; value < 256; value++) {                                                                // Same math as the per channel path, so both encode identical frames
+        encodeByte((((value * brightness) / 255) * scale) >> 8, &byteTable[value * HMS_STATUSLED_SLOTS_PER_CHANNEL]);
+    }
+    byteTableKey = key;
+}
+
+void HMS_StatusLED::encodeDithered(uint16_t level, uint16_t pixelIndex, HMS_StatusLED_EncodedSlot *slots) {
+    uint8_t fraction = level & 0xFF;
+    uint8_t offset   = pixelIndex * 0x9D;                                                                           // Odd step, neighbouring pixels do not step up on the same frame
+
+    encodeByte((level >> 8) + (fraction > ditherThreshold(ditherFrame + offset)), slots);
+    if (fraction) {
+        ditherChannels.push_back({(uint32_t)(slots - encodedData()), (uint8_t)(level >> 8), fraction, offset});
+    }
+}
+
+/*
+    HDR mode: every channel is scaled with the 16-bit brightness to 8.8 fixed point. A channel with a fraction
+    f sends level + 1 on f of every 256 frames and level on the others, so the strip averages to the exact
+    value once frames come fast enough to fuse (200+ fps). Only those channels differ between two frames of
+    the same pixels: refresh() patches just their slots in the live buffer and sends it again, the rest of the
+    frame stays as show() encoded it.
+*/
+HMS_StatusLED_StatusTypeDef HMS_StatusLED::setHDRMode(bool enabled) {
+    if (enabled && paletteBits) {
+        HMS_STATUSLED_LOG_ERROR("HDR mode needs direct color mode");
+        return HMS_STATUSLED_ERROR;
+    }
+
+    hdrMode = enabled;
+    if (enabled) {
+        ditherChannels.reserve((uint32_t)maxPixel * 3);                                                             // No allocation on the show() path
+    } else {
+        std::vector<DitherChannel>().swap(ditherChannels);
+    }
+    return HMS_STATUSLED_OK;
+}
+
+HMS_StatusLED_StatusTypeDef HMS_StatusLED::refresh() {
+    if (!hdrMode || !isOn || ditherChannels.empty()) {
+        return HMS_STATUSLED_OK;                                                                                    // Every frame would be the same, the strip already shows it
+    }
+
+    waitForTransfer();                                                                                              // The live buffer is patched in place
+    ditherFrame++;
+
+    HMS_StatusLED_EncodedSlot* data = encodedData();
+    for (const DitherChannel& channel : ditherChannels) {
+        encodeByte(channel.level + (channel.fraction > ditherThreshold(ditherFrame + channel.offset)), data + channel.slot);
+    }
+
+    if (transmit(data, encodedLength()) != HMS_STATUSLED_OK) {
+        return HMS_STATUSLED_ERROR;
+    }
+
+    HMS_STATUSLED_TRACE(HMS_STATUSLED_TRACE_SHOW, ditherChannels.size(), encodedLength());
+
+    return HMS_STATUSLED_OK;
+}
+
+HMS_StatusLED_StatusTypeDef HMS_StatusLED::cacheFrame(uint8_t frameId) {
+    if (frameId >= HMS_STATUSLED_MAX_CACHED_FRAMES) {
+        HMS_STATUSLED_LOG_ERROR("Cached frame id out of range");
+        return HMS_STATUSLED_ERROR;
+    }
+
+    waitForTransfer();                                                                                              // The live buffer may still be on the wire
+
+    #if defined(HMS_STATUSLED_PLATFORM_STM32_HAL) || defined(HMS_STATUSLED_PLATFORM_HOST)
+        updateDMABuffer();                                                                                          // Encode the current pixels exactly as show() would
+    #elif defined(HMS_STATUSLED_PLATFORM_ZEPHYR)
+        updateSPIBuffer();
+    #elif defined(HMS_STATUSLED_PLATFORM_ARDUINO) && !defined(HMS_STATUSLED_PLATFORM_ARDUINO_ESP32)
+        updateWireBuffer();
+    #else
+        updateRMTBuffer();
     #endif
-    
-    // Apply new brightness to all pixels using stored original values
-    applyBrightnessToAllPixels();
+
+    const HMS_StatusLED_EncodedSlot* data = encodedData();
+    frameCache[frameId].assign(data, data + encodedLength());
+
+    return HMS_STATUSLED_OK;
 }
 
-void HMS_StatusLED::applyBrightnessToAllPixels() {
-    for (uint16_t i = 0; i < maxPixel; i++) {
-        for (uint8_t j = 0; j < 3; j++) {
-            pixel[i][j] = (originalPixel[i][j] * brightness) / 255;
-        }
+HMS_StatusLED_StatusTypeDef HMS_StatusLED::cacheColor(uint8_t frameId, uint32_t color) {
+    if (frameId >= HMS_STATUSLED_MAX_CACHED_FRAMES) {
+        HMS_STATUSLED_LOG_ERROR("Cached frame id out of range");
+        return HMS_STATUSLED_ERROR;
+    }
+
+    uint8_t r, g, b, channels[3];
+    decodeColor(color, r, g, b);
+    switch (colorOrder) {                                                                                           // Wire order of the strip
+        case HMS_STATUSLED_ORDER_BGR:   channels[0] = b;    channels[1] = g;    channels[2] = r;    break;
+        case HMS_STATUSLED_ORDER_GRB:   channels[0] = g;    channels[1] = r;    channels[2] = b;    break;
+        case HMS_STATUSLED_ORDER_RGB:
+        default:                        channels[0] = r;    channels[1] = g;    channels[2] = b;    break;
     }
-}
\ No newline at end of file
+
+    uint16_t powerScale = calculatePowerScale((uint32_t)maxPixel * (r + g + b));                                   // Power limit of the solid frame itself, not of the framebuffer
+    waitForTransfer();                                                                                              // The slot may be the frame currently on the wire
+    uint32_t pixelSlots = (uint32_t)maxPixel * HMS_STATUSLED_SLOTS_PER_PIXEL;
+    std::vector<HMS_StatusLED_EncodedSlot>& frame = frameCache[frameId];
+    frame.resize(encodedLength());
+
+    for (uint8_t c = 0; c < 3; c++) {                                                                               // Encode one pixel, then replicate it
+        encodeByte((((channels[c] * brightness) / 255) * powerScale) >> 8, frame.data() + c * HMS_STATUSLED_SLOTS_PER_CHANNEL);
+    }
+    for (uint32_t slot = HMS_STATUSLED_SLOTS_PER_PIXEL; slot < pixelSlots; slot += HMS_STATUSLED_SLOTS_PER_PIXEL) {
+        std::copy(frame.begin(), frame.begin() + HMS_STATUSLED_SLOTS_PER_PIXEL, frame.begin() + slot);
+    }
+    std::copy(encodedData() + pixelSlots, encodedData() + encodedLength(), frame.begin() + pixelSlots);             // Reset tail is already in the live buffer
+
+    return HMS_STATUSLED_OK;
+}
+
+HMS_StatusLED_StatusTypeDef HMS_StatusLED::showCached(uint8_t frameId) {
+    if (frameId >= HMS_STATUSLED_MAX_CACHED_FRAMES || frameCache[frameId].empty()) {
+        HMS_STATUSLED_LOG_ERROR("Cached frame not registered");
+        return HMS_STATUSLED_ERROR;
+    }
+
+    ditherChannels.clear();                                                                                         // refresh() would bring back the live buffer
+    return transmit(frameCache[frameId].data(), frameCache[frameId].size());                                        // No encode work, straight to the peripheral
+}
+
+void HMS_StatusLED::releaseCachedFrame(uint8_t frameId) {
+    if (frameId < HMS_STATUSLED_MAX_CACHED_FRAMES) {
+        waitForTransfer();
+        std::vector<HMS_StatusLED_EncodedSlot>().swap(frameCache[frameId]);                                         // Give the memory back
+    }
+}
+HMS_StatusLED_StatusTypeDef HMS_StatusLED::setPaletteMode(uint8_t bitsPerPixel) {
+    if (bitsPerPixel != 0 && bitsPerPixel != 4 && bitsPerPixel != 8) {
+        HMS_STATUSLED_LOG_ERROR("Palette mode supports 4 or 8 bits per pixel");
+        return HMS_STATUSLED_ERROR;
+    }
+
+    for (uint8_t stateId = 0; stateId < HMS_STATUSLED_MAX_STATES; stateId++) {                                      // The planes they share are replaced
+        releaseState(stateId);
+    }
+
+    paletteBits = bitsPerPixel;
+    channelSum  = 0;
+
+    if (bitsPerPixel == 0) {                                                                                        // Back to direct color mode with cleared planes
+        std::vector<uint8_t>().swap(paletteIndex);
+        std::vector<uint32_t>().swap(paletteColor);
+        std::vector<uint16_t>().swap(paletteUseCount);
+        std::vector<HMS_StatusLED_EncodedSlot>().swap(paletteEncoded);
+        pixel.assign(maxPixel, std::vector<uint8_t>(3, 0));
+        originalPixel.assign(maxPixel, std::vector<uint8_t>(3, 0));
+        return HMS_STATUSLED_OK;
+    }
+
+    uint16_t entries = 1 << bitsPerPixel;
+    paletteIndex.assign(((uint32_t)maxPixel * bitsPerPixel + 7) / 8, 0);                                            // All pixels start on entry 0
+    paletteColor.assign(entries, 0);
+    paletteUseCount.assign(entries, 0);
+    paletteUseCount[0] = maxPixel;
+    paletteEncoded.resize((uint32_t)entries * HMS_STATUSLED_SLOTS_PER_PIXEL);
+    paletteDirty = true;
+
+    std::vector<std::vector<uint8_t>>().swap(pixel);                                                                // Per pixel planes are not used in indexed mode
+    std::vector<std::vector<uint8_t>>().swap(originalPixel);
+
+    HMS_STATUSLED_LOG_DEBUG("Indexed mode enabled: %d bits per pixel", bitsPerPixel);
+
+    return HMS_STATUSLED_OK;
+}
+
+HMS_StatusLED_StatusTypeDef HMS_StatusLED::setPaletteColor(uint8_t entry, uint32_t color) {
+    if (!paletteBits || entry >= paletteColor.size()) {
+        HMS_STATUSLED_LOG_ERROR("Palette entry out of range or indexed mode disabled");
+        return HMS_STATUSLED_ERROR;
+    }
+
+    uint8_t r, g, b;
+    decodeColor(color, r, g, b);
+
+    channelSum -= (uint32_t)paletteUseCount[entry] * getPaletteEntrySum(entry);                                   // Every pixel using the entry changes at once
+    paletteColor[entry] = HMS_STATUSLED_RGB_TO_888(r, g, b);
+    channelSum += (uint32_t)paletteUseCount[entry] * getPaletteEntrySum(entry);
+
+    if (!paletteDirty) encodePaletteEntry(entry);                                                                   // O(1): only this entry is re-encoded
+
+    return HMS_STATUSLED_OK;
+}
+
+HMS_StatusLED_StatusTypeDef HMS_StatusLED::setPixelIndex(uint8_t entry, uint16_t pixelIndex) {
+    if (!paletteBits || entry >= paletteColor.size() || pixelIndex >= maxPixel) {
+        HMS_STATUSLED_LOG_ERROR("Palette entry or pixel index out of range");
+        return HMS_STATUSLED_ERROR;
+    }
+
+    writePixelIndex(entry, pixelIndex);
+    return HMS_STATUSLED_OK;
+}
+
+HMS_StatusLED_StatusTypeDef HMS_StatusLED::fillIndex(uint8_t entry, uint16_t startIndex, uint16_t count) {
+    if (!paletteBits || entry >= paletteColor.size() || startIndex >= maxPixel) {
+        HMS_STATUSLED_LOG_ERROR("Palette entry or fill start index out of range");
+        return HMS_STATUSLED_ERROR;
+    }
+
+    uint16_t endIndex = (count == 0 || count > maxPixel - startIndex) ? maxPixel : startIndex + count;
+    for (uint16_t i = startIndex; i < endIndex; i++) {
+        writePixelIndex(entry, i);
+    }
+
+    return HMS_STATUSLED_OK;
+}
+
+void HMS_StatusLED::writePixelIndex(uint8_t entry, uint16_t pixelIndex) {
+    uint8_t previous = getPixelIndex(pixelIndex);
+
+    paletteUseCount[previous]--;
+    paletteUseCount[entry]++;
+    channelSum += getPaletteEntrySum(entry) - getPaletteEntrySum(previous);
+
+    if (paletteBits == 8) {
+        paletteIndex[pixelIndex] = entry;
+    } else {
+        uint8_t shift = (pixelIndex & 1) << 2;                                                                      // Even pixels use the low nibble
+        paletteIndex[pixelIndex >> 1] = (paletteIndex[pixelIndex >> 1] & ~(0x0F << shift)) | (entry << shift);
+    }
+}
+
+uint8_t HMS_StatusLED::getPixelIndex(uint16_t pixelIndex) const {
+    if (paletteBits == 8) return paletteIndex[pixelIndex];
+    return (paletteIndex[pixelIndex >> 1] >> ((pixelIndex & 1) << 2)) & 0x0F;
+}
+
+uint16_t HMS_StatusLED::getPaletteEntrySum(uint8_t entry) const {
+    uint32_t color = paletteColor[entry];
+    return HMS_STATUSLED_GET_RED_888(color) + HMS_STATUSLED_GET_GREEN_888(color) + HMS_STATUSLED_GET_BLUE_888(color);
+}
+
+void HMS_StatusLED::encodePaletteEntry(uint8_t entry) {
+    uint32_t color = paletteColor[entry];
+    uint8_t  r = HMS_STATUSLED_GET_RED_888(color), g = HMS_STATUSLED_GET_GREEN_888(color), b = HMS_STATUSLED_GET_BLUE_888(color);
+    uint8_t  channels[3];
+
+    switch (colorOrder) {                                                                                           // Order, brightness and power scale are applied once per entry
+        case HMS_STATUSLED_ORDER_BGR:   channels[0] = b;    channels[1] = g;    channels[2] = r;    break;
+        case HMS_STATUSLED_ORDER_GRB:   channels[0] = g;    channels[1] = r;    channels[2] = b;    break;
+        case HMS_STATUSLED_ORDER_RGB:
+        default:                        channels[0] = r;    channels[1] = g;    channels[2] = b;    break;
+    }
+
+    HMS_StatusLED_EncodedSlot* output = paletteEncoded.data() + (uint32_t)entry * HMS_STATUSLED_SLOTS_PER_PIXEL;
+    for (uint8_t c = 0; c < 3; c++) {
+        encodeByte((((channels[c] * brightness) / 255) * paletteScale) >> 8, output + c * HMS_STATUSLED_SLOTS_PER_CHANNEL);
+    }
+}
+
+void HMS_StatusLED::encodeIndexedFrame(uint32_t &index) {
+    uint16_t powerScale = calculatePowerScale(channelSum);
+    if (paletteDirty || powerScale != paletteScale) {                                                               // Brightness, order or power scale changed: O(palette) rebuild
+        paletteScale = powerScale;
+        for (uint16_t entry = 0; entry < paletteColor.size(); entry++) {
+            encodePaletteEntry(entry);
+        }
+        paletteDirty = false;
+    }
+
+    HMS_StatusLED_EncodedSlot*       output  = encodedData() + index;
+    const HMS_StatusLED_EncodedSlot* entries = paletteEncoded.data();
+    uint16_t source = ringOffset;
+    for (uint16_t i = 0; i < maxPixel; i++, output += HMS_STATUSLED_SLOTS_PER_PIXEL) {                                                         // Pure gather of pre-encoded entries
+        const HMS_StatusLED_EncodedSlot* entry = entries + (uint32_t)getPixelIndex(source) * HMS_STATUSLED_SLOTS_PER_PIXEL;
+        std::copy(entry, entry + HMS_STATUSLED_SLOTS_PER_PIXEL, output);
+        if (++source == maxPixel) source = 0;
+    }
+    index += (uint32_t)maxPixel * HMS_STATUSLED_SLOTS_PER_PIXEL;
+}
+#endif
+
+#if defined(HMS_STATUSLED_HAS_COMMAND_QUEUE)
+static inline int64_t renderClockUs() {
+    #if defined(HMS_STATUSLED_PLATFORM_ZEPHYR)
+        return (int64_t)k_ticks_to_us_floor64(k_uptime_ticks());
+    #elif defined(HMS_STATUSLED_PLATFORM_HOST)
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    #else
+        return esp_timer_get_time();
+    #endif
+}
+
+HMS_StatusLED_CommandQueue::HMS_StatusLED_CommandQueue() : enqueuePosition(0), dequeuePosition(0) {
+    for (uint32_t i = 0; i < HMS_STATUSLED_COMMAND_QUEUE_SIZE; i++) {
+        cells[i].sequence.store(i, std::memory_order_relaxed);                                                      // Cell i is free for position i
+    }
+}
+
+bool HMS_StatusLED_CommandQueue::push(const HMS_StatusLED_Command &command) {
+    uint32_t position = enqueuePosition.load(std::memory_order_relaxed);
+
+    for (;;) {                                                                                                      // Claim a position, producers only race on the CAS, nobody waits
+        Cell &cell = cells[position & (HMS_STATUSLED_COMMAND_QUEUE_SIZE - 1)];
+        int32_t difference = (int32_t)(cell.sequence.load(std::memory_order_acquire) - position);
+
+        if (difference == 0) {
+            if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                cell.command = command;
+                cell.sequence.store(position + 1, std::memory_order_release);                                       // Publish to the consumer
+                return true;
+            }
+        } else if (difference < 0) {
+            return false;                                                                                           // Consumer has not freed this cell yet, ring is full
+        } else {
+            position = enqueuePosition.load(std::memory_order_relaxed);                                             // Another producer took it, retry with the new head
+        }
+    }
+}
+
+bool HMS_StatusLED_CommandQueue::pop(HMS_StatusLED_Command &command) {
+    Cell &cell = cells[dequeuePosition & (HMS_STATUSLED_COMMAND_QUEUE_SIZE - 1)];
+    if (cell.sequence.load(std::memory_order_acquire) != dequeuePosition + 1) {
+        return false;                                                                                               // Empty, or the producer of this cell is still writing it
+    }
+
+    command = cell.command;
+    cell.sequence.store(dequeuePosition + HMS_STATUSLED_COMMAND_QUEUE_SIZE, std::memory_order_release);             // Hand the cell back for the next lap
+    dequeuePosition++;
+    return true;
+}
+
+#if defined(HMS_STATUSLED_PLATFORM_ZEPHYR)
+HMS_StatusLED_StatusTypeDef HMS_StatusLED::startTask(k_thread_stack_t *stack, size_t stackSize, int priority) {
+    if (ledTask || !stack) {
+        HMS_STATUSLED_LOG_ERROR("LED task already running or no stack given");
+        return HMS_STATUSLED_ERROR;
+    }
+
+    ledTask = k_thread_create(&ledThread, stack, stackSize, ledTaskEntry, this, nullptr, nullptr, priority, 0, K_NO_WAIT);
+    k_thread_name_set(ledTask, "statusled");
+    return HMS_STATUSLED_OK;
+}
+
+void HMS_StatusLED::stopTask() {
+    if (ledTask) {
+        k_thread_abort(ledTask);
+        ledTask = nullptr;
+    }
+}
+
+void HMS_StatusLED::ledTaskEntry(void *instance, void *unused1, void *unused2) {
+    (void)unused1;
+    (void)unused2;
+    HMS_StatusLED *driver = static_cast<HMS_StatusLED*>(instance);
+
+    for (;;) {
+        int64_t delay = driver->getFrameDelay();                                                                    // Sleep until new commands arrive or the pending frame is due
+        k_sem_take(&driver->commandReady, delay < 0 ? K_FOREVER : K_USEC(delay));
+        k_sem_reset(&driver->commandReady);                                                                         // One pass drains everything posted so far
+        driver->processCommands();
+    }
+}
+#elif defined(HMS_STATUSLED_PLATFORM_HOST)
+HMS_StatusLED_StatusTypeDef HMS_StatusLED::startTask() {
+    if (ledTask.joinable()) {
+        HMS_STATUSLED_LOG_ERROR("LED task already running");
+        return HMS_STATUSLED_ERROR;
+    }
+
+    stopRequested = false;
+    ledTask = std::thread(ledTaskEntry, this);
+    return HMS_STATUSLED_OK;
+}
+
+void HMS_StatusLED::stopTask() {
+    if (ledTask.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(taskMutex);
+            stopRequested = true;
+        }
+        commandReady.notify_one();
+        ledTask.join();                                                                                             // Everything the task rendered is visible to the caller afterwards
+    }
+}
+
+void HMS_StatusLED::ledTaskEntry(void *instance) {
+    HMS_StatusLED *driver = static_cast<HMS_StatusLED*>(instance);
+
+    for (;;) {
+        int64_t delay = driver->getFrameDelay();                                                                    // Sleep until new commands arrive or the pending frame is due
+        {
+            std::unique_lock<std::mutex> lock(driver->taskMutex);
+            auto woken = [driver] { return driver->commandPending || driver->stopRequested; };
+            if (delay < 0) {
+                driver->commandReady.wait(lock, woken);
+            } else {
+                driver->commandReady.wait_for(lock, std::chrono::microseconds(delay), woken);
+            }
+            if (driver->stopRequested) return;
+            driver->commandPending = false;                                                                         // One pass drains everything posted so far
+        }
+        driver->processCommands();
+    }
+}
+#else
+HMS_StatusLED_StatusTypeDef HMS_StatusLED::startTask(UBaseType_t priority, BaseType_t core) {
+    if (ledTask) {
+        HMS_STATUSLED_LOG_ERROR("LED task already running");
+        return HMS_STATUSLED_ERROR;
+    }
+
+    if (xTaskCreatePinnedToCore(ledTaskEntry, "statusled", HMS_STATUSLED_TASK_STACK_SIZE, this, priority, &ledTask, core) != pdPASS) {
+        HMS_STATUSLED_LOG_ERROR("Failed to create the LED task");
+        ledTask = nullptr;
+        return HMS_STATUSLED_ERROR;
+    }
+    return HMS_STATUSLED_OK;
+}
+
+void HMS_StatusLED::stopTask() {
+    if (ledTask) {
+        vTaskDelete(ledTask);
+        ledTask = nullptr;
+    }
+}
+
+void HMS_StatusLED::ledTaskEntry(void *instance) {
+    HMS_StatusLED *driver = static_cast<HMS_StatusLED*>(instance);
+
+    for (;;) {
+        int64_t    delay = driver->getFrameDelay();                                                                 // Sleep until new commands arrive or the pending frame is due
+        TickType_t ticks = portMAX_DELAY;
+        if (delay >= 0) {
+            ticks = pdMS_TO_TICKS((delay + 999) / 1000);
+            if (ticks == 0) ticks = 1;                                                                              // Sub-tick waits would spin at the default 100Hz tick rate
+        }
+        ulTaskNotifyTake(pdTRUE, ticks);                                                                            // Clears the count, one pass drains everything posted so far
+        driver->processCommands();
+    }
+}
+#endif
+
+void HMS_StatusLED::processCommands() {
+    HMS_StatusLED_Command command;
+
+    while (commandQueue.pop(command)) {
+        switch (command.type) {
+            case HMS_STATUSLED_COMMAND_PIXEL:           setPixelColor(command.value, command.index);                break;
+            case HMS_STATUSLED_COMMAND_FILL:            fill(command.value, command.index, command.count);          break;
+            case HMS_STATUSLED_COMMAND_BRIGHTNESS:      setBrightness((uint8_t)command.value);                      break;
+            case HMS_STATUSLED_COMMAND_POWER:           if (command.value) turnOn(); else turnOff();                break;
+            case HMS_STATUSLED_COMMAND_POWER_BUDGET:    setPowerBudget(command.value, milliAmpsPerChannel);         break;
+            case HMS_STATUSLED_COMMAND_SHOW:            pendingShows++;                                             break;
+            default:                                                                                                break;
+        }
+    }
+
+    if (getFrameDelay() != 0) return;                                                                               // Nothing to show, or the frame rate cap is not over yet
+
+    if (pendingShows == 0) {
+        refresh();                                                                                                  // HDR mode: next dither frame of the same pixels
+    } else {
+        show();                                                                                                     // One transmit for every show request since the last frame
+        coalescedFrames.fetch_add(pendingShows - 1, std::memory_order_relaxed);
+        pendingShows = 0;
+    }
+    lastRenderTime = renderClockUs();
+}
+
+int64_t HMS_StatusLED::getFrameDelay() const {
+    int64_t interval = frameInterval.load(std::memory_order_relaxed);
+    if (pendingShows == 0) {
+        if (HMS_STATUSLED_HDR_REFRESH_HZ == 0 || !hdrMode || !isOn || ditherChannels.empty()) return -1;
+        interval = 1000000 / (HMS_STATUSLED_HDR_REFRESH_HZ ? HMS_STATUSLED_HDR_REFRESH_HZ : 1);                     // Dither frames run at their own rate, not the frame rate cap
+    }
+
+    int64_t elapsed  = renderClockUs() - lastRenderTime;
+    return elapsed >= interval ? 0 : interval - elapsed;
+}
+
+void HMS_StatusLED::setMaxFps(uint16_t fps) {
+    frameInterval.store(fps ? 1000000UL / fps : 0, std::memory_order_relaxed);
+}
+
+HMS_StatusLED_StatusTypeDef HMS_StatusLED::enqueue(const HMS_StatusLED_Command &command, bool fromISR) {
+    if (!commandQueue.push(command)) {
+        droppedCommands.fetch_add(1, std::memory_order_relaxed);                                                    // No logging here, this may run in an ISR
+        return HMS_STATUSLED_ERROR;
+    }
+
+    #if defined(HMS_STATUSLED_PLATFORM_ZEPHYR)
+        (void)fromISR;                                                                                              // k_sem_give is ISR safe
+        k_sem_give(&commandReady);
+    #elif defined(HMS_STATUSLED_PLATFORM_HOST)
+        (void)fromISR;                                                                                              // Signal handlers must not post, the mutex is not async-signal-safe
+        {
+            std::lock_guard<std::mutex> lock(taskMutex);
+            commandPending = true;
+        }
+        commandReady.notify_one();
+    #else
+        TaskHandle_t task = ledTask;
+        if (task) {
+            if (fromISR) {
+                BaseType_t higherPriorityTaskWoken = pdFALSE;
+                vTaskNotifyGiveFromISR(task, &higherPriorityTaskWoken);
+                portYIELD_FROM_ISR(higherPriorityTaskWoken);
+            } else {
+                xTaskNotifyGive(task);
+            }
+        }
+    #endif
+    return HMS_STATUSLED_OK;
+}
+
+HMS_StatusLED_StatusTypeDef HMS_StatusLED::post(const HMS_StatusLED_Command &command) {
+    return enqueue(command, false);
+}
+
+HMS_StatusLED_StatusTypeDef HMS_StatusLED::postPixelColor(uint32_t color, uint16_t pixelIndex) {
+    return enqueue({HMS_STATUSLED_COMMAND_PIXEL, pixelIndex, 1, color}, false);
+}
+
+HMS_StatusLED_StatusTypeDef HMS_StatusLED::postFill(uint32_t color, uint16_t startIndex, uint16_t count) {
+    return enqueue({HMS_STATUSLED_COMMAND_FILL, startIndex, count, color}, false);
+}
+
+HMS_StatusLED_StatusTypeDef HMS_StatusLED::postBrightness(uint8_t brightness) {
+    return enqueue({HMS_STATUSLED_COMMAND_BRIGHTNESS, 0, 0, brightness}, false);
+}
+
+HMS_StatusLED_StatusTypeDef HMS_StatusLED::postPower(bool on) {
+    return enqueue({HMS_STATUSLED_COMMAND_POWER, 0, 0, (uint32_t)on}, false);
+}
+
+HMS_StatusLED_StatusTypeDef HMS_StatusLED::postPowerBudget(uint32_t maxMilliAmps) {
+    return enqueue({HMS_STATUSLED_COMMAND_POWER_BUDGET, 0, 0, maxMilliAmps}, false);
+}
+
+HMS_StatusLED_StatusTypeDef HMS_StatusLED::postShow() {
+    return enqueue({HMS_STATUSLED_COMMAND_SHOW, 0, 0, 0}, false);
+}
+
+HMS_StatusLED_StatusTypeDef HMS_StatusLED::setPixelColorFromISR(uint32_t color, uint16_t pixelIndex) {
+    return enqueue({HMS_STATUSLED_COMMAND_PIXEL, pixelIndex, 1, color}, true);
+}
+#endif
+
+void HMS_StatusLED::getChannelMap(HMS_StatusLED_OrderType order, uint8_t channelMap[3]) const {
+    static const uint8_t orderChannels[3][3] = {                                                                    // Channel (0=R, 1=G, 2=B) carried by each wire position
+        {0, 1, 2},                                                                                                  // HMS_STATUSLED_ORDER_RGB
+        {2, 1, 0},                                                                                                  // HMS_STATUSLED_ORDER_BGR
+        {1, 0, 2},                                                                                                  // HMS_STATUSLED_ORDER_GRB
+    };
+    const uint8_t* wanted = orderChannels[order <= HMS_STATUSLED_ORDER_GRB ? order : 0];
+
+    channelMap[0] = wanted[0];                                                                                      // Pixels are stored as R, G, B, the order is applied on the wire only
+    channelMap[1] = wanted[1];
+    channelMap[2] = wanted[2];
+}
+
+HMS_StatusLED_StatusTypeDef HMS_StatusLED::addSegment(uint16_t start, uint16_t length, HMS_StatusLED_OrderType order, uint8_t flags, uint8_t *segmentId) {
+    if (length == 0 || start >= maxPixel || length > maxPixel - start || segments.size() >= HMS_STATUSLED_MAX_SEGMENTS) {
+        HMS_STATUSLED_LOG_ERROR("Invalid segment range or segment table full");
+        return HMS_STATUSLED_ERROR;
+    }
+
+    size_t insertAt = 0;
+    for (; insertAt < segmentOrder.size(); insertAt++) {                                                            // Find sorted position and reject overlaps
+        const HMS_StatusLED_Segment& other = segments[segmentOrder[insertAt]];
+        if (start < other.start + other.length && other.start < start + length) {
+            HMS_STATUSLED_LOG_ERROR("Segment overlaps an existing segment");
+            return HMS_STATUSLED_ERROR;
+        }
+        if (start < other.start) break;
+    }
+
+    HMS_StatusLED_Segment segment;
+    segment.start       = start;
+    segment.length      = length;
+    segment.colorOrder  = order;
+    segment.brightness  = 255;
+    segment.isOn        = true;
+    segment.flags       = flags;
+
+    segments.push_back(segment);
+    segmentOrder.insert(segmentOrder.begin() + insertAt, (uint8_t)(segments.size() - 1));
+    if (segmentId) *segmentId = (uint8_t)(segments.size() - 1);
+
+    HMS_STATUSLED_LOG_DEBUG("Segment %d added: start %d, length %d", (int)(segments.size() - 1), start, length);
+
+    return HMS_STATUSLED_OK;
+}
+
+void HMS_StatusLED::clearSegments() {
+    segments.clear();
+    segmentOrder.clear();
+}
+
+HMS_StatusLED_SegmentView HMS_StatusLED::segment(uint8_t segmentId) {
+    return HMS_StatusLED_SegmentView(this, segmentId);
+}
+
+HMS_StatusLED_SegmentView::HMS_StatusLED_SegmentView(HMS_StatusLED *driver, uint8_t segmentId)
+  : driver(driver), segmentId(segmentId) {
+}
+
+bool HMS_StatusLED_SegmentView::isValid() const {
+    return driver && segmentId < driver->segments.size();
+}
+
+uint16_t HMS_StatusLED_SegmentView::length() const {
+    return isValid() ? driver->segments[segmentId].length : 0;
+}
+
+void HMS_StatusLED_SegmentView::turnOn() {
+    if (isValid()) driver->segments[segmentId].isOn = true;                                                         // Pixels stay untouched, the encoder skips the segment while off
+}
+
+void HMS_StatusLED_SegmentView::turnOff() {
+    if (isValid()) driver->segments[segmentId].isOn = false;
+}
+
+void HMS_StatusLED_SegmentView::setBrightness(uint8_t brightness) {
+    if (isValid()) driver->segments[segmentId].brightness = brightness;                                             // Relative to the strip brightness, applied at encode time
+}
+
+HMS_StatusLED_StatusTypeDef HMS_StatusLED_SegmentView::setPixelColor(uint32_t color, uint16_t pixelIndex) {
+    if (!isValid() || pixelIndex >= driver->segments[segmentId].length) return HMS_STATUSLED_ERROR;
+    return driver->setPixelColor(color, driver->segments[segmentId].start + pixelIndex);
+}
+
+HMS_StatusLED_StatusTypeDef HMS_StatusLED_SegmentView::fill(uint32_t color) {
+    if (!isValid()) return HMS_STATUSLED_ERROR;
+    return driver->fill(color, driver->segments[segmentId].start, driver->segments[segmentId].length);
+}
+
+HMS_StatusLED_StatusTypeDef HMS_StatusLED::setPixelColor(uint32_t color, uint16_t pixelIndex) {
+    return setPixelColor(color, pixelIndex, colorOrder);
+}
+
+HMS_StatusLED_StatusTypeDef HMS_StatusLED::setPixelColor(uint32_t color, uint16_t pixelIndex, HMS_StatusLED_OrderType colorOrder) {
+    if (pixelIndex >= maxPixel || paletteBits) {                                                                    // Validate pixel index (indexed mode uses setPixelIndex)
+        HMS_STATUSLED_LOG_ERROR("Pixel index out of range");
+        return HMS_STATUSLED_ERROR;
+    }
+
+    uint8_t r, g, b;
+    decodeColor(color, r, g, b);
+    storeRGB(pixelIndex, r, g, b, colorOrder);
+
+    HMS_STATUSLED_TRACE(HMS_STATUSLED_TRACE_PIXEL, pixelIndex, color);
+
+    return HMS_STATUSLED_OK;
+}
+
+void HMS_StatusLED::storeRGB(uint16_t pixelIndex, uint8_t r, uint8_t g, uint8_t b, HMS_StatusLED_OrderType order) {
+    if (order == colorOrder) {
+        storePixel(pixelIndex, r, g, b);                                                                            // Stored as R, G, B, the encoder applies the strip order
+        return;
+    }
+
+    for (const HMS_StatusLED_Segment& segment : segments) {                                                         // The order of a segment always wins over a per-pixel order
+        if (pixelIndex >= segment.start && pixelIndex - segment.start < segment.length) {
+            storePixel(pixelIndex, r, g, b);
+            return;
+        }
+    }
+
+    uint8_t color[3] = {r, g, b}, stored[3], strip[3], wanted[3];                                                   // Per-pixel wire order: store the channels so the strip order puts them there
+    getChannelMap(colorOrder, strip);
+    getChannelMap(order, wanted);
+    for (uint8_t position = 0; position < 3; position++) {
+        stored[strip[position]] = color[wanted[position]];
+    }
+    storePixel(pixelIndex, stored[0], stored[1], stored[2]);
+}
+
+void HMS_StatusLED::decodeColor(uint32_t color, uint8_t &r, uint8_t &g, uint8_t &b) const {
+    unpackColor(color, r, g, b);
+    applyGamma(r, g, b);
+}
+
+void HMS_StatusLED::unpackColor(uint32_t color, uint8_t &r, uint8_t &g, uint8_t &b) const {                       // RGB888 unless tagged with HMS_STATUSLED_565()
+    if (color & HMS_STATUSLED_COLOR_565_FLAG) {                                                                     // Value ranges overlap (0x00FF00 is valid in both), only the tag is reliable
+        expand565((uint16_t)color, r, g, b);
+    } else {
+        r = HMS_STATUSLED_GET_RED_888(color);
+        g = HMS_STATUSLED_GET_GREEN_888(color);
+        b = HMS_STATUSLED_GET_BLUE_888(color);
+    }
+}
+
+void HMS_StatusLED::setColorOrder(HMS_StatusLED_OrderType order) {
+    colorOrder = order;
+    #if defined(HMS_STATUSLED_HAS_ENCODER)
+        paletteDirty = true;                                                                                        // Palette entries carry the wire order
+        encodeAll    = true;                                                                                        // So does every encoded pixel, the stored ones are R, G, B
+    #endif
+    
+    HMS_STATUSLED_LOG_DEBUG("Color order set to: %d", order);
+}
+
+void HMS_StatusLED::clear() {
+    #if defined(HMS_STATUSLED_HAS_ENCODER)
+        if (paletteBits) {                                                                                          // Indexed mode: every pixel back to palette entry 0
+            std::fill(paletteIndex.begin(), paletteIndex.end(), 0);
+            std::fill(paletteUseCount.begin(), paletteUseCount.end(), 0);
+            paletteUseCount[0] = maxPixel;
+            channelSum = (uint32_t)maxPixel * getPaletteEntrySum(0);
+            return;
+        }
+    #endif
+
+    for (uint16_t block = 0; stateCount && block < blockEpoch.size(); block++) {                                    // Saved states keep what is cleared here
+        if (blockEpoch[block] != stateEpoch) preserveBlock(block);
+    }
+
+    for (auto& pixelData : pixel) {                                                                                // Clear all pixel data
+        std::fill(pixelData.begin(), pixelData.end(), 0);
+    }
+    for (auto& pixelData : originalPixel) {                                                                        // Clear original pixel data too
+        std::fill(pixelData.begin(), pixelData.end(), 0);
+    }
+    channelSum = 0;
+    markEncodeDirty(0, maxPixel);
+    
+    HMS_STATUSLED_LOG_DEBUG("All pixels cleared");
+}
+
+void HMS_StatusLED::turnOff() {
+    if (isOn) {
+        isOn = false;                                                                                               // Pixel data is kept, the encoder sends an all-zero frame while off
+
+        HMS_STATUSLED_TRACE(HMS_STATUSLED_TRACE_POWER, 0, 0);
+    }
+}
+
+void HMS_StatusLED::turnOn() {
+    if (!isOn) {
+        isOn = true;                                                                                                // Next show() re-encodes the kept pixel data at the current brightness
+
+        HMS_STATUSLED_TRACE(HMS_STATUSLED_TRACE_POWER, 1, 0);
+    }
+}
+
+void HMS_StatusLED::setBrightness(uint8_t newBrightness) {
+    brightness   = newBrightness;
+    brightness16 = newBrightness * 257;                                                                             // 255 -> 65535
+    
+    HMS_STATUSLED_TRACE(HMS_STATUSLED_TRACE_BRIGHTNESS, brightness, brightness16);
+    
+    // Apply new brightness to all pixels using stored original values
+    applyBrightnessToAllPixels();
+}
+
+void HMS_StatusLED::setBrightness16(uint16_t newBrightness) {
+    brightness16 = newBrightness;
+    brightness   = (newBrightness + 256) / 257;                                                                     // Rounded up, so direct and indexed mode keep dim levels visible
+
+    HMS_STATUSLED_TRACE(HMS_STATUSLED_TRACE_BRIGHTNESS, brightness, brightness16);
+
+    applyBrightnessToAllPixels();
+}
+
+void HMS_StatusLED::applyBrightnessToAllPixels() {
+    #if defined(HMS_STATUSLED_HAS_ENCODER)
+        if (paletteBits) {                                                                                          // Indexed mode: O(palette) re-encode on the next frame
+            paletteDirty = true;
+            return;
+        }
+        encodeAll = true;
+        if (!byteTable.empty()) return;                                                                             // Table mode: O(256) table rebuild on the next frame
+    #endif
+
+    for (uint16_t i = 0; i < maxPixel; i++) {
+        for (uint8_t j = 0; j < 3; j++) {
+            pixel[i][j] = (originalPixel[i][j] * brightness) / 255;
+        }
+    }
+}
+
+void HMS_StatusLED::storePixel(uint16_t pixelIndex, uint8_t c0, uint8_t c1, uint8_t c2) {
+    std::vector<uint8_t>& original = originalPixel[pixelIndex];
+
+    if (stateCount) {                                                                                               // First write to the block since a save: copy it out once
+        uint16_t block = pixelIndex / HMS_STATUSLED_STATE_BLOCK_PIXELS;
+        if (blockEpoch[block] != stateEpoch) preserveBlock(block);
+    }
+    markEncodeDirty(pixelIndex, pixelIndex + 1);
+
+    channelSum -= original[0] + original[1] + original[2];                                                          // Incremental update, no strip rescan
+    channelSum += c0 + c1 + c2;
+
+    original[0] = c0;   original[1] = c1;   original[2] = c2;
+    pixel[pixelIndex][0] = (c0 * brightness) / 255;                                                                 // Apply brightness scaling (0-255)
+    pixel[pixelIndex][1] = (c1 * brightness) / 255;
+    pixel[pixelIndex][2] = (c2 * brightness) / 255;
+}
+
+HMS_StatusLED_StatusTypeDef HMS_StatusLED::fill(uint32_t color, uint16_t startIndex, uint16_t count) {
+    if (startIndex >= maxPixel) {
+        HMS_STATUSLED_LOG_ERROR("Fill start index out of range");
+        return HMS_STATUSLED_ERROR;
+    }
+
+    uint16_t endIndex = (count == 0 || count > maxPixel - startIndex) ? maxPixel : startIndex + count;
+
+    if (setPixelColor(color, startIndex) != HMS_STATUSLED_OK) {                                                     // Convert the color once, then replicate the stored channels
+        return HMS_STATUSLED_ERROR;
+    }
+    const std::vector<uint8_t>& source = originalPixel[startIndex];
+    for (uint16_t i = startIndex + 1; i < endIndex; i++) {
+        storePixel(i, source[0], source[1], source[2]);
+    }
+
+    HMS_STATUSLED_TRACE(HMS_STATUSLED_TRACE_FILL, endIndex - startIndex, color);                                   // Start index is in the PIXEL record just before
+
+    return HMS_STATUSLED_OK;
+}
+
+HMS_StatusLED_StatusTypeDef HMS_StatusLED::setPixelRGB(uint8_t r, uint8_t g, uint8_t b, uint16_t pixelIndex) {
+    if (pixelIndex >= maxPixel || paletteBits) {
+        HMS_STATUSLED_LOG_ERROR("Pixel index out of range");
+        return HMS_STATUSLED_ERROR;
+    }
+
+    applyGamma(r, g, b);
+    storeRGB(pixelIndex, r, g, b, colorOrder);
+    return HMS_STATUSLED_OK;
+}
+
+HMS_StatusLED_StatusTypeDef HMS_StatusLED::setPixelColor565(uint16_t color, uint16_t pixelIndex) {
+    uint8_t r, g, b;
+    expand565(color, r, g, b);
+    return setPixelRGB(r, g, b, pixelIndex);
+}
+
+HMS_StatusLED_StatusTypeDef HMS_StatusLED::setPixelColor888(uint32_t color, uint16_t pixelIndex) {
+    return setPixelRGB(HMS_STATUSLED_GET_RED_888(color), HMS_STATUSLED_GET_GREEN_888(color), HMS_STATUSLED_GET_BLUE_888(color), pixelIndex);
+}
+
+HMS_StatusLED_StatusTypeDef HMS_StatusLED::setPixels565(const uint16_t *colors, uint16_t count, uint16_t startIndex) {
+    if (!colors || startIndex >= maxPixel || paletteBits) {
+        HMS_STATUSLED_LOG_ERROR("Invalid colors or start index out of range");
+        return HMS_STATUSLED_ERROR;
+    }
+
+    uint16_t endIndex = (count > maxPixel - startIndex) ? maxPixel : startIndex + count;                            // Clipped at the end of the strip
+    for (uint16_t i = startIndex; i < endIndex; i++) {
+        uint8_t r, g, b;
+        expand565(*colors++, r, g, b);
+        applyGamma(r, g, b);
+        storeRGB(i, r, g, b, colorOrder);
+    }
+    return HMS_STATUSLED_OK;
+}
+
+HMS_StatusLED_StatusTypeDef HMS_StatusLED::setPixels888(const uint32_t *colors, uint16_t count, uint16_t startIndex) {
+    if (!colors || startIndex >= maxPixel || paletteBits) {
+        HMS_STATUSLED_LOG_ERROR("Invalid colors or start index out of range");
+        return HMS_STATUSLED_ERROR;
+    }
+
+    uint16_t endIndex = (count > maxPixel - startIndex) ? maxPixel : startIndex + count;
+    for (uint16_t i = startIndex; i < endIndex; i++) {
+        storePacked(i, *colors++);
+    }
+    return HMS_STATUSLED_OK;
+}
+
+HMS_StatusLED_StatusTypeDef HMS_StatusLED::setPixelsRGB(const uint8_t *rgb, uint16_t count, uint16_t startIndex) {
+    if (!rgb || startIndex >= maxPixel || paletteBits) {
+        HMS_STATUSLED_LOG_ERROR("Invalid colors or start index out of range");
+        return HMS_STATUSLED_ERROR;
+    }
+
+    uint16_t endIndex = (count > maxPixel - startIndex) ? maxPixel : startIndex + count;
+    for (uint16_t i = startIndex; i < endIndex; i++, rgb += 3) {
+        uint8_t r = rgb[0], g = rgb[1], b = rgb[2];
+        applyGamma(r, g, b);
+        storeRGB(i, r, g, b, colorOrder);
+    }
+    return HMS_STATUSLED_OK;
+}
+
+uint32_t HMS_StatusLED::colorHSV(uint8_t hue, uint8_t saturation, uint8_t value) {
+    uint8_t r, g, b;
+    hsvToRgb(hue, saturation, value, r, g, b);
+    return HMS_STATUSLED_RGB_TO_888(r, g, b);
+}
+
+/*
+    shift(), rotate() and mirror() move whole pixels by reordering the per pixel channel vectors of both
+    planes: only the vector handles move, no channel bytes are converted or copied and nothing is allocated.
+    A chaser moving one pixel costs one rotate() instead of rewriting every pixel through setPixelColor().
+    When no data has to move at all, setRingOffset() makes the encoder start at another pixel instead.
+*/
+static void reversePlane(std::vector<std::vector<uint8_t>> &plane, uint16_t start, uint16_t end) {
+    while (start + 1 < end) {
+        plane[start++].swap(plane[--end]);                                                                          // Swaps the buffer pointers, not the channels
+    }
+}
+
+HMS_StatusLED_StatusTypeDef HMS_StatusLED::prepareMove(uint16_t startIndex, uint16_t count, uint16_t &endIndex) {
+    if (startIndex >= maxPixel || paletteBits) {
+        HMS_STATUSLED_LOG_ERROR("Move start index out of range or indexed mode active");
+        return HMS_STATUSLED_ERROR;
+    }
+
+    endIndex = (count == 0 || count > maxPixel - startIndex) ? maxPixel : startIndex + count;
+
+    for (uint16_t block = startIndex / HMS_STATUSLED_STATE_BLOCK_PIXELS; stateCount && block <= (endIndex - 1) / HMS_STATUSLED_STATE_BLOCK_PIXELS; block++) {
+        if (blockEpoch[block] != stateEpoch) preserveBlock(block);                                                  // Saved states keep the pixels moved here
+    }
+    markEncodeDirty(startIndex, endIndex);
+
+    return HMS_STATUSLED_OK;
+}
+
+HMS_StatusLED_StatusTypeDef HMS_StatusLED::rotate(int16_t distance, uint16_t startIndex, uint16_t count) {
+    uint16_t endIndex;
+    if (prepareMove(startIndex, count, endIndex) != HMS_STATUSLED_OK) {
+        return HMS_STATUSLED_ERROR;
+    }
+
+    int32_t  length = endIndex - startIndex;
+    uint16_t steps  = ((distance % length) + length) % length;                                                      // Towards the strip end
+    if (steps) {                                                                                                    // Three reversals, every pixel is swapped about twice
+        uint16_t split = endIndex - steps;
+        for (std::vector<std::vector<uint8_t>>* plane : {&pixel, &originalPixel}) {
+            reversePlane(*plane, startIndex, split);
+            reversePlane(*plane, split, endIndex);
+            reversePlane(*plane, startIndex, endIndex);
+        }
+    }
+    return HMS_STATUSLED_OK;
+}
+
+HMS_StatusLED_StatusTypeDef HMS_StatusLED::shift(int16_t distance, uint16_t startIndex, uint16_t count) {
+    uint16_t endIndex;
+    if (prepareMove(startIndex, count, endIndex) != HMS_STATUSLED_OK) {
+        return HMS_STATUSLED_ERROR;
+    }
+
+    int32_t length  = endIndex - startIndex;
+    int32_t vacated = distance < 0 ? -(int32_t)distance : distance;
+    if (vacated < length) {
+        rotate(distance, startIndex, length);
+    } else {
+        vacated = length;                                                                                           // Everything moved out
+    }
+
+    uint16_t first = (distance < 0) ? endIndex - vacated : startIndex;
+    for (uint16_t i = first; i < first + vacated; i++) {
+        storePixel(i, 0, 0, 0);                                                                                     // Subtracts the pixels rotated in here from channelSum
+    }
+    return HMS_STATUSLED_OK;
+}
+
+HMS_StatusLED_StatusTypeDef HMS_StatusLED::mirror(uint16_t startIndex, uint16_t count) {
+    uint16_t endIndex;
+    if (prepareMove(startIndex, count, endIndex) != HMS_STATUSLED_OK) {
+        return HMS_STATUSLED_ERROR;
+    }
+
+    reversePlane(pixel, startIndex, endIndex);
+    reversePlane(originalPixel, startIndex, endIndex);
+    return HMS_STATUSLED_OK;
+}
+
+#if defined(HMS_STATUSLED_HAS_ENCODER)
+void HMS_StatusLED::setRingOffset(uint16_t offset) {
+    offset = maxPixel ? offset % maxPixel : 0;
+    if (offset != ringOffset) {
+        ringOffset = offset;
+        encodeAll  = true;                                                                                          // Every strip position shows another pixel now
+    }
+}
+#endif
+
+HMS_StatusLED_StatusTypeDef HMS_StatusLED::setPixelHSV(uint8_t hue, uint8_t saturation, uint8_t value, uint16_t pixelIndex) {
+    if (pixelIndex >= maxPixel || paletteBits) {
+        HMS_STATUSLED_LOG_ERROR("Pixel index out of range");
+        return HMS_STATUSLED_ERROR;
+    }
+
+    uint8_t r, g, b;
+    hsvToRgb(hue, saturation, value, r, g, b);                                                                      // No RGB565/RGB888 guess, the channels are known
+    applyGamma(r, g, b);
+    storeRGB(pixelIndex, r, g, b, colorOrder);
+    return HMS_STATUSLED_OK;
+}
+
+HMS_StatusLED_StatusTypeDef HMS_StatusLED::fillRainbow(uint16_t startIndex, uint16_t count, uint8_t hueStart, uint8_t hueDelta) {
+    if (startIndex >= maxPixel || paletteBits) {
+        HMS_STATUSLED_LOG_ERROR("Rainbow start index out of range");
+        return HMS_STATUSLED_ERROR;
+    }
+
+    uint16_t endIndex = (count == 0 || count > maxPixel - startIndex) ? maxPixel : startIndex + count;
+    uint16_t hue      = (uint16_t)hueStart << 8;                                                                    // 8.8 fixed point, keeps fractional steps on long strips
+    uint16_t step     = hueDelta ? (uint16_t)hueDelta << 8 : (uint16_t)(65536UL / (endIndex - startIndex));
+
+    for (uint16_t i = startIndex; i < endIndex; i++, hue += step) {                                                 // Straight into storePixel, no per pixel decode or logging
+        uint8_t r, g, b;
+        hsvToRgb(hue >> 8, 255, 255, r, g, b);
+        applyGamma(r, g, b);
+        storeRGB(i, r, g, b, colorOrder);
+    }
+
+    return HMS_STATUSLED_OK;
+}
+
+HMS_StatusLED_StatusTypeDef HMS_StatusLED::setLayerCount(uint8_t count) {
+    if (count > HMS_STATUSLED_MAX_LAYERS) {
+        HMS_STATUSLED_LOG_ERROR("Maximum number of layers reached");
+        return HMS_STATUSLED_ERROR;
+    }
+
+    HMS_StatusLED_Layer layer;
+    layer.pixels.assign(maxPixel, 0);                                                                               // Fully transparent
+    layer.opacity   = 255;
+    layer.blendMode = HMS_STATUSLED_BLEND_NORMAL;
+
+    layers.resize(count, layer);
+    layers.shrink_to_fit();
+    markDirty(0, maxPixel);
+    return HMS_STATUSLED_OK;
+}
+
+HMS_StatusLED_StatusTypeDef HMS_StatusLED::setLayerPixel(uint8_t layer, uint16_t pixelIndex, uint32_t color, uint8_t alpha) {
+    if (layer >= layers.size() || pixelIndex >= maxPixel) {
+        HMS_STATUSLED_LOG_ERROR("Layer or pixel index out of range");
+        return HMS_STATUSLED_ERROR;
+    }
+
+    layers[layer].pixels[pixelIndex] = ((uint32_t)alpha << 24) | (color & 0xFFFFFF);
+    markDirty(pixelIndex, pixelIndex + 1);
+    return HMS_STATUSLED_OK;
+}
+
+HMS_StatusLED_StatusTypeDef HMS_StatusLED::fillLayer(uint8_t layer, uint32_t color, uint8_t alpha, uint16_t startIndex, uint16_t count) {
+    if (layer >= layers.size() || startIndex >= maxPixel) {
+        HMS_STATUSLED_LOG_ERROR("Layer or start index out of range");
+        return HMS_STATUSLED_ERROR;
+    }
+
+    uint16_t endIndex = (count == 0 || count > maxPixel - startIndex) ? maxPixel : startIndex + count;
+    std::fill(layers[layer].pixels.begin() + startIndex, layers[layer].pixels.begin() + endIndex, ((uint32_t)alpha << 24) | (color & 0xFFFFFF));
+    markDirty(startIndex, endIndex);
+    return HMS_STATUSLED_OK;
+}
+
+HMS_StatusLED_StatusTypeDef HMS_StatusLED::setLayerOpacity(uint8_t layer, uint8_t opacity) {
+    if (layer >= layers.size()) return HMS_STATUSLED_ERROR;
+    if (layers[layer].opacity != opacity) {
+        layers[layer].opacity = opacity;
+        markDirty(0, maxPixel);
+    }
+    return HMS_STATUSLED_OK;
+}
+
+HMS_StatusLED_StatusTypeDef HMS_StatusLED::setLayerBlendMode(uint8_t layer, HMS_StatusLED_BlendMode mode) {
+    if (layer >= layers.size()) return HMS_STATUSLED_ERROR;
+    if (layers[layer].blendMode != mode) {
+        layers[layer].blendMode = mode;
+        markDirty(0, maxPixel);
+    }
+    return HMS_STATUSLED_OK;
+}
+
+static inline void extendRange(uint16_t &rangeStart, uint16_t &rangeEnd, uint16_t start, uint16_t end) {
+    if (rangeStart == rangeEnd) {                                                                                   // Clean, the range starts here
+        rangeStart = start;
+        rangeEnd   = end;
+        return;
+    }
+    if (start < rangeStart) rangeStart = start;
+    if (end   > rangeEnd)   rangeEnd   = end;
+}
+
+void HMS_StatusLED::markDirty(uint16_t start, uint16_t end) {
+    extendRange(dirtyStart, dirtyEnd, start, end);
+}
+
+void HMS_StatusLED::markEncodeDirty(uint16_t start, uint16_t end) {
+    extendRange(encodeStart, encodeEnd, start, end);
+}
+
+HMS_StatusLED_StatusTypeDef HMS_StatusLED::composite() {
+    if (layers.empty() || paletteBits) {
+        HMS_STATUSLED_LOG_ERROR("No layers allocated or indexed mode active");
+        return HMS_STATUSLED_ERROR;
+    }
+
+    for (uint16_t i = dirtyStart; i < dirtyEnd; i++) {                                                              // Pixels outside the dirty range are already up to date
+        uint32_t output = 0;
+        for (const HMS_StatusLED_Layer& layer : layers) {
+            uint32_t source = layer.pixels[i];
+            uint16_t weight = ((source >> 24) * (layer.opacity + 1)) >> 8;
+            if (weight == 0) continue;
+            weight += weight >> 7;                                                                                  // 0-255 to 0-256, so 255 replaces the pixel below exactly
+
+            if (layer.blendMode == HMS_STATUSLED_BLEND_ADD) {
+                output = addSaturatePacked(output, scalePacked(source, weight));
+            } else {
+                output = blendPacked(output, source, weight);
+            }
+        }
+        storePacked(i, output);
+    }
+
+    dirtyStart = dirtyEnd = 0;
+    return HMS_STATUSLED_OK;
+}
+
+HMS_StatusLED_StatusTypeDef HMS_StatusLED::crossfade(const uint32_t *fromFrame, const uint32_t *toFrame, uint8_t t, uint16_t startIndex, uint16_t count) {
+    if (!fromFrame || !toFrame || startIndex >= maxPixel || paletteBits) {
+        HMS_STATUSLED_LOG_ERROR("Invalid crossfade frames or start index");
+        return HMS_STATUSLED_ERROR;
+    }
+
+    uint16_t endIndex = (count == 0 || count > maxPixel - startIndex) ? maxPixel : startIndex + count;
+    uint16_t weight   = t + (t >> 7);
+
+    for (uint16_t i = startIndex; i < endIndex; i++) {                                                              // Frames are indexed from startIndex
+        storePacked(i, blendPacked(fromFrame[i - startIndex], toFrame[i - startIndex], weight));
+    }
+
+    return HMS_STATUSLED_OK;
+}
+
+/*
+    Effect kernels are pure functions of the effect, the time and the pixel position: no state between frames,
+    so any frame can be rendered at any time and two strips given the same clock stay in step. The type and
+    everything that only depends on the time is resolved once per call; the per pixel loops are straight line
+    integer code (masks instead of compares, table lookups instead of sin() / pow()), so a frame costs the same
+    whatever the colors or positions are. Ranges are rendered HMS_STATUSLED_EFFECT_CHUNK pixels at a time into a
+    packed RGB888 buffer on the stack, the pixel plane is written with storePacked() like a crossfade.
+*/
+#define HMS_STATUSLED_EFFECT_CHUNK            32
+
+static void runEffectKernel(const HMS_StatusLED_Effect &effect, uint32_t nowMs, uint32_t *frame, uint16_t first, uint16_t length, uint16_t total) {
+    uint16_t period = effect.periodMs ? effect.periodMs : 1;
+    uint32_t cycle  = nowMs / period;                                                                               // Whole periods since the clock started
+    uint16_t phase  = ((nowMs - cycle * period) << 16) / period;                                                    // Position in the current period, 0.16 fixed point
+    uint8_t  size   = effect.size ? effect.size : 1;
+    uint32_t color  = effect.color & 0x00FFFFFF;
+    uint32_t ground = effect.background & 0x00FFFFFF;
+    uint32_t diff   = color ^ ground;
+
+    switch (effect.type) {
+        case HMS_STATUSLED_EFFECT_BREATHE: {
+            uint16_t level  = sineAt(phase) >> 8;
+            uint32_t output = blendPacked(ground, color, level + (level >> 7));
+            for (uint16_t i = 0; i < length; i++) frame[i] = output;
+            break;
+        }
+        case HMS_STATUSLED_EFFECT_BLINK: {
+            uint32_t output = ground ^ (diff & ((phase >> 15) - 1));                                                // First half color, second half background
+            for (uint16_t i = 0; i < length; i++) frame[i] = output;
+            break;
+        }
+        case HMS_STATUSLED_EFFECT_CHASE: {
+            int32_t head = ((uint32_t)phase * total) >> 16;
+            for (uint16_t i = 0; i < length; i++) {
+                int32_t distance = first + i - head;
+                distance += total & (distance >> 31);                                                               // Wrap around the end of the range
+                frame[i] = ground ^ (diff & ((distance - size) >> 31));                                             // size pixels from the head on
+            }
+            break;
+        }
+        case HMS_STATUSLED_EFFECT_SCANNER: {
+            int32_t  center = ((uint32_t)(total - 1) * sineAt(phase)) / 255;                                        // 8.8 fixed point, eases in and out at both ends
+            int32_t  radius = (int32_t)size << 8;
+            uint32_t scale  = 65536UL / size;
+            for (uint16_t i = 0; i < length; i++) {
+                int32_t distance = ((int32_t)(first + i) << 8) - center;
+                int32_t sign     = distance >> 31;
+                distance         = clampRange(radius - ((distance ^ sign) - sign), radius);
+                frame[i] = blendPacked(ground, color, easeWeight((distance * scale) >> 16));
+            }
+            break;
+        }
+        case HMS_STATUSLED_EFFECT_RAINBOW: {
+            uint16_t step = 65536UL / total;
+            uint16_t hue  = phase + (uint16_t)((uint32_t)first * step);                                             // 8.8 fixed point, one wheel over the range
+            for (uint16_t i = 0; i < length; i++, hue += step) {
+                uint8_t r, g, b;
+                hsvToRgb(hue >> 8, 255, 255, r, g, b);
+                frame[i] = HMS_STATUSLED_RGB_TO_888(r, g, b);
+            }
+            break;
+        }
+        case HMS_STATUSLED_EFFECT_SPARKLE: {
+            uint16_t fade = easeWeight(256 - (phase >> 8));                                                         // Every sparkle fades out over its period
+            for (uint16_t i = 0; i < length; i++) {
+                uint32_t lit = (int32_t)((hashPixel(first + i, cycle) & 0xFF) - size) >> 31;                        // size / 256 of the pixels per period
+                frame[i] = blendPacked(ground, color, fade & lit);
+            }
+            break;
+        }
+        case HMS_STATUSLED_EFFECT_FIRE: {
+            uint32_t cooling = ((uint32_t)size << 16) / total;                                                      // Heat lost per pixel away from the base, 8.16
+            uint32_t fall    = (uint32_t)first * cooling;
+            uint16_t blend   = phase >> 8;
+            for (uint16_t i = 0; i < length; i++, fall += cooling) {
+                uint32_t now   = hashPixel(first + i, cycle) & 0xFF;                                                // Value noise, faded from this period's to the next
+                uint32_t next  = hashPixel(first + i, cycle + 1) & 0xFF;
+                int32_t  flame = (now * (256 - blend) + next * blend) >> 8;
+                int32_t  heat  = ((128 + (flame >> 1)) * (256 - (int32_t)(fall >> 16))) >> 8;                       // Hot base, cooling towards the tip
+                heat *= 3;                                                                                          // Black, red, yellow, white
+                frame[i] = HMS_STATUSLED_RGB_TO_888(clampRange(heat, 255), clampRange(heat - 255, 255), clampRange(heat - 510, 255));
+            }
+            break;
+        }
+        case HMS_STATUSLED_EFFECT_COMET: {
+            int32_t  head  = ((uint32_t)phase * total) >> 8;                                                        // 8.8 fixed point
+            int32_t  tail  = (int32_t)size << 8;
+            int32_t  wrap  = (int32_t)total << 8;
+            uint32_t scale = 65536UL / size;
+            for (uint16_t i = 0; i < length; i++) {
+                int32_t distance = head - ((int32_t)(first + i) << 8);
+                distance += wrap & (distance >> 31);                                                                // The tail continues at the end of the range
+                distance  = clampRange(tail - distance, tail);
+                frame[i] = blendPacked(ground, color, easeWeight((distance * scale) >> 16));
+            }
+            break;
+        }
+        case HMS_STATUSLED_EFFECT_PROGRESS: {
+            int32_t filled = ((uint32_t)effect.size * total * 256) / 255;                                           // 8.8 fixed point, the last pixel is partially lit
+            for (uint16_t i = 0; i < length; i++) {
+                frame[i] = blendPacked(ground, color, clampRange(filled - ((int32_t)(first + i) << 8), 256));
+            }
+            break;
+        }
+        default:
+            for (uint16_t i = 0; i < length; i++) frame[i] = ground;
+            break;
+    }
+}
+
+void HMS_StatusLED::renderEffectFrame(const HMS_StatusLED_Effect &effect, uint32_t nowMs, uint32_t *frame, uint16_t count) {
+    if (!frame || count == 0) return;
+    runEffectKernel(effect, nowMs, frame, 0, count, count);
+}
+
+HMS_StatusLED_StatusTypeDef HMS_StatusLED::renderEffect(const HMS_StatusLED_Effect &effect, uint32_t nowMs, uint16_t startIndex, uint16_t count) {
+    if (startIndex >= maxPixel || paletteBits) {
+        HMS_STATUSLED_LOG_ERROR("Effect start index out of range");
+        return HMS_STATUSLED_ERROR;
+    }
+
+    uint16_t endIndex = (count == 0 || count > maxPixel - startIndex) ? maxPixel : startIndex + count;
+    uint32_t chunk[HMS_STATUSLED_EFFECT_CHUNK];
+
+    for (uint32_t first = startIndex; first < endIndex; first += HMS_STATUSLED_EFFECT_CHUNK) {
+        uint16_t length = (endIndex - first < HMS_STATUSLED_EFFECT_CHUNK) ? endIndex - first : HMS_STATUSLED_EFFECT_CHUNK;
+        runEffectKernel(effect, nowMs, chunk, first - startIndex, length, endIndex - startIndex);
+        for (uint16_t i = 0; i < length; i++) {
+            storePacked(first + i, chunk[i]);
+        }
+    }
+
+    return HMS_STATUSLED_OK;
+}
+
+/*
+    Saved states share the pixel planes copy-on-write, in blocks of HMS_STATUSLED_STATE_BLOCK_PIXELS pixels.
+    saveState() copies nothing, it only advances stateEpoch. The first write to a block after that (storePixel()
+    compares the block's epoch) copies the block into the pool once, for every state still sharing it, so a
+    state costs RAM only for the blocks written while it is kept. restoreState() writes back the preserved blocks
+    alone, and only the pixels in them that differ, through storePixel(): they land in the encode range and the
+    next show() re-encodes just those pixels.
+*/
+#define HMS_STATUSLED_STATE_SHARED      0xFFFF                                                                      // Block entry of a state that still matches the live pixels
+
+void HMS_StatusLED::preserveBlock(uint16_t block) {
+    uint16_t poolBlock = HMS_STATUSLED_STATE_SHARED;
+
+    for (SavedState& state : states) {
+        if (!state.used || state.blocks[block] != HMS_STATUSLED_STATE_SHARED) continue;                             // Already has its own copy from an earlier write
+
+        if (poolBlock == HMS_STATUSLED_STATE_SHARED) {                                                              // One copy for all states sharing the block
+            for (poolBlock = 0; poolBlock < statePoolRefs.size() && statePoolRefs[poolBlock]; poolBlock++) {}
+            if (poolBlock == statePoolRefs.size()) {
+                statePoolRefs.push_back(0);
+                statePool.resize(statePool.size() + HMS_STATUSLED_STATE_BLOCK_PIXELS * 3);
+            }
+
+            uint8_t* copy  = &statePool[(uint32_t)poolBlock * HMS_STATUSLED_STATE_BLOCK_PIXELS * 3];
+            uint16_t first = block * HMS_STATUSLED_STATE_BLOCK_PIXELS;
+            uint16_t end   = (maxPixel - first < HMS_STATUSLED_STATE_BLOCK_PIXELS) ? maxPixel : first + HMS_STATUSLED_STATE_BLOCK_PIXELS;
+            for (uint16_t i = first; i < end; i++, copy += 3) {
+                copy[0] = originalPixel[i][0];  copy[1] = originalPixel[i][1];  copy[2] = originalPixel[i][2];
+            }
+        }
+
+        state.blocks[block] = poolBlock;
+        statePoolRefs[poolBlock]++;
+    }
+
+    blockEpoch[block] = stateEpoch;                                                                                 // Later writes skip this until the next save or restore
+}
+
+HMS_StatusLED_StatusTypeDef HMS_StatusLED::saveState(uint8_t stateId) {
+    if (stateId >= HMS_STATUSLED_MAX_STATES || paletteBits) {
+        HMS_STATUSLED_LOG_ERROR("State id out of range or indexed mode active");
+        return HMS_STATUSLED_ERROR;
+    }
+
+    releaseState(stateId);                                                                                          // Saving over an id replaces it
+
+    uint16_t blocks = (maxPixel + HMS_STATUSLED_STATE_BLOCK_PIXELS - 1) / HMS_STATUSLED_STATE_BLOCK_PIXELS;
+    if (blockEpoch.size() != blocks) blockEpoch.assign(blocks, 0);
+
+    SavedState& state  = states[stateId];
+    state.blocks.assign(blocks, HMS_STATUSLED_STATE_SHARED);
+    state.brightness16 = brightness16;
+    state.isOn         = isOn;
+    state.used         = true;
+    stateCount++;
+    stateEpoch++;                                                                                                   // Every block is shared again, the next write to it preserves it
+
+    return HMS_STATUSLED_OK;
+}
+
+HMS_StatusLED_StatusTypeDef HMS_StatusLED::restoreState(uint8_t stateId) {
+    if (stateId >= HMS_STATUSLED_MAX_STATES || !states[stateId].used || paletteBits) {
+        HMS_STATUSLED_LOG_ERROR("State not saved or indexed mode active");
+        return HMS_STATUSLED_ERROR;
+    }
+
+    SavedState& state = states[stateId];
+    for (uint16_t block = 0; block < state.blocks.size(); block++) {
+        uint16_t poolBlock = state.blocks[block];
+        if (poolBlock == HMS_STATUSLED_STATE_SHARED) continue;                                                      // Not written since the save
+        if (blockEpoch[block] != stateEpoch) preserveBlock(block);                                                  // Other states first, the pool may grow
+
+        const uint8_t* copy  = &statePool[(uint32_t)poolBlock * HMS_STATUSLED_STATE_BLOCK_PIXELS * 3];
+        uint16_t       first = block * HMS_STATUSLED_STATE_BLOCK_PIXELS;
+        uint16_t       end   = (maxPixel - first < HMS_STATUSLED_STATE_BLOCK_PIXELS) ? maxPixel : first + HMS_STATUSLED_STATE_BLOCK_PIXELS;
+        for (uint16_t i = first; i < end; i++, copy += 3) {
+            const std::vector<uint8_t>& live = originalPixel[i];
+            if (live[0] != copy[0] || live[1] != copy[1] || live[2] != copy[2]) {                                   // Unchanged pixels stay out of the encode range
+                storePixel(i, copy[0], copy[1], copy[2]);
+            }
+        }
+
+        state.blocks[block] = HMS_STATUSLED_STATE_SHARED;                                                           // Live pixels match the state again
+        statePoolRefs[poolBlock]--;
+    }
+    stateEpoch++;                                                                                                   // The state keeps its saved content through later writes
+
+    if (state.brightness16 != brightness16) setBrightness16(state.brightness16);
+    if (state.isOn) turnOn(); else turnOff();
+
+    return HMS_STATUSLED_OK;
+}
+
+void HMS_StatusLED::releaseState(uint8_t stateId) {
+    if (stateId >= HMS_STATUSLED_MAX_STATES || !states[stateId].used) return;
+
+    SavedState& state = states[stateId];
+    for (uint16_t poolBlock : state.blocks) {
+        if (poolBlock != HMS_STATUSLED_STATE_SHARED) statePoolRefs[poolBlock]--;
+    }
+    std::vector<uint16_t>().swap(state.blocks);
+    state.used = false;
+
+    uint8_t kept = 0;
+    for (uint8_t i = 0; i < stateDepth; i++) {                                                                      // Not on the stack any more either
+        if (stateStack[i] != stateId) stateStack[kept++] = stateStack[i];
+    }
+    stateDepth = kept;
+
+    if (--stateCount == 0) {                                                                                        // Last state gone, give the pool back
+        std::vector<uint8_t>().swap(statePool);
+        std::vector<uint8_t>().swap(statePoolRefs);
+        std::vector<uint32_t>().swap(blockEpoch);
+    }
+}
+
+HMS_StatusLED_StatusTypeDef HMS_StatusLED::pushState() {
+    for (int16_t stateId = HMS_STATUSLED_MAX_STATES - 1; stateId >= 0; stateId--) {                                 // From the top, low ids stay free for named states
+        if (states[stateId].used) continue;
+        if (saveState(stateId) != HMS_STATUSLED_OK) return HMS_STATUSLED_ERROR;
+        stateStack[stateDepth++] = stateId;
+        return HMS_STATUSLED_OK;
+    }
+
+    HMS_STATUSLED_LOG_ERROR("No free state to push");
+    return HMS_STATUSLED_ERROR;
+}
+
+HMS_StatusLED_StatusTypeDef HMS_StatusLED::popState() {
+    if (stateDepth == 0) {
+        HMS_STATUSLED_LOG_ERROR("State stack empty");
+        return HMS_STATUSLED_ERROR;
+    }
+
+    uint8_t stateId = stateStack[--stateDepth];
+    HMS_StatusLED_StatusTypeDef status = restoreState(stateId);
+    releaseState(stateId);
+
+    return status;
+}
+
+uint16_t HMS_StatusLED::getStateBlockCount() const {
+    uint16_t count = 0;
+    for (uint8_t refs : statePoolRefs) count += (refs != 0);
+    return count;
+}
+
+/*
+    Animation container, little endian, read in place from flash or a memory mapped file:
+
+      Header (12 bytes)   "HMSA", version (1), flags (HMS_STATUSLED_ANIMATION_LOOP), pixelCount (16), frameCount (16), reserved (16)
+      Frame  (8 bytes)    type (KEY / DELTA), reserved, durationMs (16), payload length (32), then the payload
+
+    KEY payloads are pixelCount RGB888 triplets. DELTA payloads are ops applied to the pixels of the previous
+    frame, each op byte holds the kind in the top two bits and count - 1 (1..64 pixels) in the low six:
+    SKIP leaves pixels as they are, RUN repeats the one RGB triplet that follows, LITERAL is followed by count
+    triplets. Pixels after the last op are unchanged. Colors are stored before gamma, like setPixelColor().
+*/
+#define HMS_STATUSLED_ANIMATION_HEADER_SIZE   12
+#define HMS_STATUSLED_ANIMATION_FRAME_SIZE    8
+#define HMS_STATUSLED_ANIMATION_VERSION       1
+#define HMS_STATUSLED_ANIMATION_KEY           0
+#define HMS_STATUSLED_ANIMATION_DELTA         1
+#define HMS_STATUSLED_ANIMATION_OP_SKIP       0x00
+#define HMS_STATUSLED_ANIMATION_OP_RUN        0x40
+#define HMS_STATUSLED_ANIMATION_OP_LITERAL    0x80
+#define HMS_STATUSLED_ANIMATION_OP_MAX        64                                                                    // Pixels per op
+
+static inline uint16_t readLE16(const uint8_t *data) {
+    return (uint16_t)(data[0] | (data[1] << 8));
+}
+
+static inline uint32_t readLE32(const uint8_t *data) {
+    return (uint32_t)data[0] | ((uint32_t)data[1] << 8) | ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24);
+}
+
+HMS_StatusLED_StatusTypeDef HMS_StatusLED::playAnimation(const uint8_t *data, uint32_t size) {
+    if (!data || size < HMS_STATUSLED_ANIMATION_HEADER_SIZE || data[0] != 'H' || data[1] != 'M' || data[2] != 'S' ||
+        data[3] != 'A' || data[4] != HMS_STATUSLED_ANIMATION_VERSION || paletteBits) {
+        HMS_STATUSLED_LOG_ERROR("Invalid animation container");
+        return HMS_STATUSLED_ERROR;
+    }
+
+    animationData    = data;
+    animationSize    = size;
+    animationOffset  = HMS_STATUSLED_ANIMATION_HEADER_SIZE;
+    animationFrame   = 0;
+    animationPlaying = true;
+    animationDuration = 0;                                                                                          // First updateAnimation() shows frame 0 right away
+
+    HMS_STATUSLED_LOG_DEBUG("Animation started: %u pixels, %u frames", readLE16(data + 6), readLE16(data + 8));
+    return HMS_STATUSLED_OK;
+}
+
+HMS_StatusLED_StatusTypeDef HMS_StatusLED::updateAnimation(uint32_t nowMs) {
+    if (!animationPlaying) return HMS_STATUSLED_OK;
+
+    uint32_t elapsed = nowMs - animationFrameStart;
+    if (elapsed < animationDuration) return HMS_STATUSLED_OK;                                                       // Current frame is still on the strip
+
+    if (animationFrame >= readLE16(animationData + 8)) {
+        if (!(animationData[5] & HMS_STATUSLED_ANIMATION_LOOP)) {
+            animationPlaying = false;                                                                               // Last frame stays on the strip
+            return HMS_STATUSLED_OK;
+        }
+        animationOffset = HMS_STATUSLED_ANIMATION_HEADER_SIZE;
+        animationFrame  = 0;
+    }
+
+    uint32_t frameOffset = animationOffset;
+    if (decodeAnimationFrame() != HMS_STATUSLED_OK) {
+        animationPlaying = false;
+        return HMS_STATUSLED_ERROR;
+    }
+
+    animationFrameStart = (elapsed < 2U * animationDuration) ? animationFrameStart + animationDuration : nowMs;     // Keep the cadence, resync after a long stall
+    animationDuration   = readLE16(animationData + frameOffset + 2);                                               // Header was bounds checked by decodeAnimationFrame()
+
+    return show();
+}
+
+HMS_StatusLED_StatusTypeDef HMS_StatusLED::decodeAnimationFrame() {
+    if (animationOffset + HMS_STATUSLED_ANIMATION_FRAME_SIZE > animationSize) {
+        HMS_STATUSLED_LOG_ERROR("Animation frame header out of range");
+        return HMS_STATUSLED_ERROR;
+    }
+
+    const uint8_t *frame   = animationData + animationOffset;
+    uint32_t       length  = readLE32(frame + 4);
+    const uint8_t *payload = frame + HMS_STATUSLED_ANIMATION_FRAME_SIZE;
+    if (length > animationSize - animationOffset - HMS_STATUSLED_ANIMATION_FRAME_SIZE) {
+        HMS_STATUSLED_LOG_ERROR("Animation frame payload out of range");
+        return HMS_STATUSLED_ERROR;
+    }
+
+    uint16_t pixelCount = readLE16(animationData + 6);
+    if (pixelCount > maxPixel) pixelCount = maxPixel;                                                               // Pixels past the strip are not shown
+
+    if (frame[0] == HMS_STATUSLED_ANIMATION_KEY) {
+        if (length < (uint32_t)readLE16(animationData + 6) * 3) {
+            HMS_STATUSLED_LOG_ERROR("Animation keyframe too short");
+            return HMS_STATUSLED_ERROR;
+        }
+        setPixelsRGB(payload, pixelCount, 0);
+    } else if (frame[0] == HMS_STATUSLED_ANIMATION_DELTA) {
+        const uint8_t *end   = payload + length;
+        uint32_t       pixel = 0;
+        while (payload < end) {
+            uint8_t  op    = *payload & 0xC0;
+            uint32_t count = (*payload++ & 0x3F) + 1;
+            uint32_t bytes = (op == HMS_STATUSLED_ANIMATION_OP_RUN) ? 3 : (op == HMS_STATUSLED_ANIMATION_OP_LITERAL) ? count * 3 : 0;
+            if (op == 0xC0 || (uint32_t)(end - payload) < bytes) {
+                HMS_STATUSLED_LOG_ERROR("Corrupt animation delta frame");
+                return HMS_STATUSLED_ERROR;
+            }
+
+            uint32_t visible = (pixel < pixelCount) ? ((count < pixelCount - pixel) ? count : pixelCount - pixel) : 0;
+            if (op == HMS_STATUSLED_ANIMATION_OP_RUN) {
+                uint8_t r = payload[0], g = payload[1], b = payload[2];
+                applyGamma(r, g, b);                                                                                // Once per run, not per pixel
+                for (uint32_t i = 0; i < visible; i++) {
+                    storeRGB(pixel + i, r, g, b, colorOrder);
+                }
+            } else if (op == HMS_STATUSLED_ANIMATION_OP_LITERAL && visible) {
+                setPixelsRGB(payload, visible, pixel);
+            }
+            payload += bytes;
+            pixel   += count;
+        }
+    } else {
+        HMS_STATUSLED_LOG_ERROR("Unknown animation frame type");
+        return HMS_STATUSLED_ERROR;
+    }
+
+    animationOffset += HMS_STATUSLED_ANIMATION_FRAME_SIZE + length;
+    animationFrame++;
+    return HMS_STATUSLED_OK;
+}
+
+void HMS_StatusLED::createAnimation(std::vector<uint8_t> &container, uint16_t pixelCount, uint8_t flags) {
+    const uint8_t header[HMS_STATUSLED_ANIMATION_HEADER_SIZE] = {
+        'H', 'M', 'S', 'A', HMS_STATUSLED_ANIMATION_VERSION, flags,
+        (uint8_t)pixelCount, (uint8_t)(pixelCount >> 8), 0, 0, 0, 0
+    };
+    container.assign(header, header + HMS_STATUSLED_ANIMATION_HEADER_SIZE);
+}
+
+HMS_StatusLED_StatusTypeDef HMS_StatusLED::appendAnimationFrame(std::vector<uint8_t> &container, const uint32_t *frame,
+                                                                const uint32_t *previous, uint16_t durationMs) {
+    if (!frame || container.size() < HMS_STATUSLED_ANIMATION_HEADER_SIZE || readLE16(container.data() + 8) == 0xFFFF) {
+        return HMS_STATUSLED_ERROR;
+    }
+
+    uint16_t pixelCount = readLE16(container.data() + 6);
+    size_t   start      = container.size();
+    container.insert(container.end(), HMS_STATUSLED_ANIMATION_FRAME_SIZE, 0);
+
+    auto pushColor = [&container](uint32_t color) {
+        container.push_back((uint8_t)(color >> 16));
+        container.push_back((uint8_t)(color >> 8));
+        container.push_back((uint8_t)color);
+    };
+
+    uint8_t type = HMS_STATUSLED_ANIMATION_KEY;
+    if (previous) {                                                                                                 // Greedy ops: unchanged pixels skip, repeats become runs
+        uint16_t i = 0;
+        while (i < pixelCount) {
+            uint16_t j = i;
+            if ((frame[i] & 0xFFFFFF) == (previous[i] & 0xFFFFFF)) {
+                while (j < pixelCount && (frame[j] & 0xFFFFFF) == (previous[j] & 0xFFFFFF)) j++;
+                if (j == pixelCount) break;                                                                         // Trailing unchanged pixels need no op
+                for (uint16_t n = j - i; n; ) {
+                    uint8_t chunk = n > HMS_STATUSLED_ANIMATION_OP_MAX ? HMS_STATUSLED_ANIMATION_OP_MAX : n;
+                    container.push_back(HMS_STATUSLED_ANIMATION_OP_SKIP | (chunk - 1));
+                    n -= chunk;
+                }
+            } else {
+                while (j < pixelCount && (frame[j] & 0xFFFFFF) == (frame[i] & 0xFFFFFF)) j++;
+                if (j - i >= 2) {
+                    for (uint16_t n = j - i; n; ) {
+                        uint8_t chunk = n > HMS_STATUSLED_ANIMATION_OP_MAX ? HMS_STATUSLED_ANIMATION_OP_MAX : n;
+                        container.push_back(HMS_STATUSLED_ANIMATION_OP_RUN | (chunk - 1));
+                        pushColor(frame[i]);
+                        n -= chunk;
+                    }
+                } else {
+                    j = i + 1;                                                                                      // Literal up to the next unchanged pixel or repeat
+                    while (j < pixelCount && j - i < HMS_STATUSLED_ANIMATION_OP_MAX &&
+                           (frame[j] & 0xFFFFFF) != (previous[j] & 0xFFFFFF) &&
+                           (j + 1 >= pixelCount || (frame[j + 1] & 0xFFFFFF) != (frame[j] & 0xFFFFFF))) j++;
+                    container.push_back(HMS_STATUSLED_ANIMATION_OP_LITERAL | (j - i - 1));
+                    for (uint16_t n = i; n < j; n++) pushColor(frame[n]);
+                }
+            }
+            i = j;
+        }
+
+        if (container.size() - start - HMS_STATUSLED_ANIMATION_FRAME_SIZE < (size_t)pixelCount * 3) {
+            type = HMS_STATUSLED_ANIMATION_DELTA;
+        } else {
+            container.resize(start + HMS_STATUSLED_ANIMATION_FRAME_SIZE);                                          // Delta is not smaller, store a keyframe instead
+        }
+    }
+
+    if (type == HMS_STATUSLED_ANIMATION_KEY) {
+        for (uint16_t i = 0; i < pixelCount; i++) pushColor(frame[i]);
+    }
+
+    uint32_t length = container.size() - start - HMS_STATUSLED_ANIMATION_FRAME_SIZE;
+    uint8_t *header = container.data() + start;
+    header[0] = type;
+    header[2] = (uint8_t)durationMs;    header[3] = (uint8_t)(durationMs >> 8);
+    header[4] = (uint8_t)length;        header[5] = (uint8_t)(length >> 8);
+    header[6] = (uint8_t)(length >> 16);header[7] = (uint8_t)(length >> 24);
+
+    uint16_t frameCount = readLE16(container.data() + 8) + 1;
+    container[8] = (uint8_t)frameCount; container[9] = (uint8_t)(frameCount >> 8);
+
+    return HMS_STATUSLED_OK;
+}
+
+void HMS_StatusLED::storePacked(uint16_t pixelIndex, uint32_t color) {
+    uint8_t r = HMS_STATUSLED_GET_RED_888(color), g = HMS_STATUSLED_GET_GREEN_888(color), b = HMS_STATUSLED_GET_BLUE_888(color);
+    applyGamma(r, g, b);
+    storeRGB(pixelIndex, r, g, b, colorOrder);
+}
+
+HMS_StatusLED_StatusTypeDef HMS_StatusLED::fillGradient(uint32_t startColor, uint32_t endColor, uint16_t startIndex, uint16_t count) {
+    if (startIndex >= maxPixel || paletteBits) {
+        HMS_STATUSLED_LOG_ERROR("Gradient start index out of range");
+        return HMS_STATUSLED_ERROR;
+    }
+
+    uint16_t endIndex = (count == 0 || count > maxPixel - startIndex) ? maxPixel : startIndex + count;
+    uint16_t steps    = endIndex - startIndex - 1;
+
+    uint8_t from[3], to[3];
+    unpackColor(startColor, from[0], from[1], from[2]);                                                             // Interpolate before gamma so the blend is perceptually even
+    unpackColor(endColor,   to[0],   to[1],   to[2]);
+
+    int32_t channel[3], delta[3];                                                                                   // 16.16 fixed point accumulators
+    for (uint8_t c = 0; c < 3; c++) {
+        channel[c] = ((int32_t)from[c] << 16) + 0x8000;
+        delta[c]   = steps ? (((int32_t)to[c] - from[c]) * 65536) / steps : 0;
+    }
+
+    for (uint16_t i = startIndex; i < endIndex; i++) {
+        uint8_t r = channel[0] >> 16, g = channel[1] >> 16, b = channel[2] >> 16;
+        applyGamma(r, g, b);
+        storeRGB(i, r, g, b, colorOrder);
+        channel[0] += delta[0];     channel[1] += delta[1];     channel[2] += delta[2];
+    }
+
+    return HMS_STATUSLED_OK;
+}
+
+void HMS_StatusLED::setPowerBudget(uint32_t maxMilliAmps, uint8_t milliAmpsPerChannel) {
+    powerBudget = maxMilliAmps;
+    this->milliAmpsPerChannel = milliAmpsPerChannel;
+
+    HMS_STATUSLED_LOG_DEBUG("Power budget set to %lu mA (%d mA per channel)", (unsigned long)maxMilliAmps, milliAmpsPerChannel);
+}
+
+uint32_t HMS_StatusLED::getEstimatedCurrent() const {
+    if (!isOn) return 0;
+
+    uint64_t requested = ((uint64_t)channelSum * brightness16 * milliAmpsPerChannel) / (255UL * 65535UL);          // Draw of the current frame at the current brightness
+    return (uint32_t)((requested * calculatePowerScale(channelSum)) >> 8);
+}
+
+uint16_t HMS_StatusLED::calculatePowerScale(uint32_t sum) const {
+    if (powerBudget == 0) return 256;
+
+    uint64_t requested = ((uint64_t)sum * brightness16 * milliAmpsPerChannel) / (255UL * 65535UL);
+    if (requested <= powerBudget) return 256;
+
+    return (uint16_t)(((uint64_t)powerBudget << 8) / requested);                                                    // Rounds down so the limited draw never exceeds the budget
+}
+
+uint16_t HMS_StatusLED::readTrace(HMS_StatusLED_TraceRecord *records, uint16_t maxRecords) {
+    #if defined(HMS_STATUSLED_TRACE_ENABLED) && (HMS_STATUSLED_TRACE_ENABLED == 1)
+        uint32_t head = HMS_STATUSLED_TRACE_HEAD();
+        if (head - traceTail > HMS_STATUSLED_TRACE_DEPTH) {
+            traceTail = head - HMS_STATUSLED_TRACE_DEPTH;                                                           // Older records were overwritten
+        }
+
+        uint16_t count = 0;
+        while (count < maxRecords && traceTail != head) {
+            records[count++] = traceRing[traceTail++ & (HMS_STATUSLED_TRACE_DEPTH - 1)];
+        }
+        return count;
+    #else
+        (void)records;
+        (void)maxRecords;
+        return 0;
+    #endif
+}
+
+void HMS_StatusLED::dumpTrace() {
+    HMS_StatusLED_TraceRecord record;
+    char line[48];
+    while (readTrace(&record, 1)) {
+        snprintf(line, sizeof(line), "%10lu %-10s %5u 0x%08lX", (unsigned long)record.timestamp,
+                 getTraceEventName(record.event), (unsigned)record.arg0, (unsigned long)record.arg1);
+        #if defined(HMS_STATUSLED_PLATFORM_ARDUINO)
+            Serial.println(line);                                                                                   // Not every Arduino core has Serial.printf
+        #else
+            printf("%s\n", line);
+        #endif
+    }
+}
+
+const char* HMS_StatusLED::getTraceEventName(uint8_t event) {
+    switch (event) {
+        case HMS_STATUSLED_TRACE_SHOW:          return "SHOW";
+        case HMS_STATUSLED_TRACE_PIXEL:         return "PIXEL";
+        case HMS_STATUSLED_TRACE_FILL:          return "FILL";
+        case HMS_STATUSLED_TRACE_BRIGHTNESS:    return "BRIGHTNESS";
+        case HMS_STATUSLED_TRACE_POWER:         return "POWER";
+        default:                                return "UNKNOWN";
+    }
+}
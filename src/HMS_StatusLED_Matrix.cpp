@@ -0,0 +1,160 @@
+#include "HMS_StatusLED_Matrix.h"
+#include <string.h>
+
+/*
+    The layout is resolved once: the constructor walks every position of the rotated matrix through rotation,
+    panel tiling and the wiring of a panel, and keeps the strip index in remap. Addressing a pixel is one
+    lookup after that.
+
+    Rows are written as runs: positions next to each other that are also next to each other on the strip (a
+    row of a row-wired panel, forwards or backwards on serpentine rows). A forward run of a blit goes to
+    setPixelsRGB() straight from the bitmap, a backward one is reversed in chunks first, so the pixel plane
+    is always written in ascending order. Column-wired panels only have runs along the columns, their rows
+    fall back to one pixel per run.
+*/
+
+#define HMS_STATUSLED_MATRIX_CHUNK      32                                                                          // Pixels reversed per step of a backward run
+
+static uint16_t findRun(const uint16_t *map, uint16_t count, int8_t &step) {
+    step = 1;
+    if (count < 2 || map[0] == HMS_STATUSLED_MATRIX_NONE) return 1;
+
+    if (map[0] > 0 && map[1] == map[0] - 1) step = -1;                                                              // Serpentine row running backwards
+
+    uint16_t length = 1;
+    while (length < count && (step > 0 || length <= map[0]) && map[length] == (uint16_t)(map[0] + step * length)) {
+        length++;
+    }
+    return length;
+}
+
+HMS_StatusLED_Matrix::HMS_StatusLED_Matrix(HMS_StatusLED &driver, uint16_t panelWidth, uint16_t panelHeight, uint8_t flags,
+                                           uint8_t tilesX, uint8_t tilesY, HMS_StatusLED_MatrixRotation rotation)
+  : driver(driver) {
+    if (tilesX == 0) tilesX = 1;
+    if (tilesY == 0) tilesY = 1;
+
+    uint16_t physicalWidth  = panelWidth * tilesX;
+    uint16_t physicalHeight = panelHeight * tilesY;
+    bool     sideways       = (rotation == HMS_STATUSLED_MATRIX_ROTATE_90 || rotation == HMS_STATUSLED_MATRIX_ROTATE_270);
+    uint32_t panelPixels    = (uint32_t)panelWidth * panelHeight;
+
+    width  = sideways ? physicalHeight : physicalWidth;
+    height = sideways ? physicalWidth : physicalHeight;
+    remap.resize((uint32_t)width * height);
+
+    for (uint16_t y = 0; y < height; y++) {
+        for (uint16_t x = 0; x < width; x++) {
+            uint16_t px, py;
+            switch (rotation) {
+                case HMS_STATUSLED_MATRIX_ROTATE_90:    px = physicalWidth - 1 - y;     py = x;                         break;
+                case HMS_STATUSLED_MATRIX_ROTATE_180:   px = physicalWidth - 1 - x;     py = physicalHeight - 1 - y;    break;
+                case HMS_STATUSLED_MATRIX_ROTATE_270:   px = y;                         py = physicalHeight - 1 - x;    break;
+                default:                                px = x;                         py = y;                         break;
+            }
+
+            uint16_t tileX = px / panelWidth,   localX = px % panelWidth;
+            uint16_t tileY = py / panelHeight,  localY = py % panelHeight;
+            if ((flags & HMS_STATUSLED_MATRIX_TILE_SERPENTINE) && (tileY & 1)) tileX = tilesX - 1 - tileX;
+
+            uint32_t index = ((uint32_t)tileY * tilesX + tileX) * panelPixels;
+            if (flags & HMS_STATUSLED_MATRIX_COLUMNS) {
+                bool backwards = (flags & HMS_STATUSLED_MATRIX_SERPENTINE) && (localX & 1);
+                index += (uint32_t)localX * panelHeight + (backwards ? panelHeight - 1 - localY : localY);
+            } else {
+                bool backwards = (flags & HMS_STATUSLED_MATRIX_SERPENTINE) && (localY & 1);
+                index += (uint32_t)localY * panelWidth + (backwards ? panelWidth - 1 - localX : localX);
+            }
+
+            remap[(uint32_t)y * width + x] = (index < driver.getPixelCount()) ? index : HMS_STATUSLED_MATRIX_NONE;
+        }
+    }
+}
+
+uint16_t HMS_StatusLED_Matrix::getIndex(uint16_t x, uint16_t y) const {
+    if (x >= width || y >= height) return HMS_STATUSLED_MATRIX_NONE;
+    return remap[(uint32_t)y * width + x];
+}
+
+HMS_StatusLED_StatusTypeDef HMS_StatusLED_Matrix::setPixelXY(uint32_t color, uint16_t x, uint16_t y) {
+    uint16_t index = getIndex(x, y);
+    if (index == HMS_STATUSLED_MATRIX_NONE) return HMS_STATUSLED_ERROR;
+    return driver.setPixelColor(color, index);
+}
+
+void HMS_StatusLED_Matrix::fillRow(uint32_t color, uint16_t x, uint16_t y, uint16_t length) {
+    const uint16_t* map = &remap[(uint32_t)y * width + x];
+
+    while (length) {
+        int8_t   step;
+        uint16_t run = findRun(map, length, step);
+        if (map[0] != HMS_STATUSLED_MATRIX_NONE) {
+            driver.fill(color, step > 0 ? map[0] : map[0] - (run - 1), run);                                        // Color is converted once per run
+        }
+        map    += run;
+        length -= run;
+    }
+}
+
+HMS_StatusLED_StatusTypeDef HMS_StatusLED_Matrix::drawRect(uint32_t color, int16_t x, int16_t y, uint16_t w, uint16_t h, bool filled) {
+    int32_t left   = x < 0 ? 0 : x;
+    int32_t top    = y < 0 ? 0 : y;
+    int32_t right  = ((int32_t)x + w < width)  ? (int32_t)x + w : width;                                            // Exclusive
+    int32_t bottom = ((int32_t)y + h < height) ? (int32_t)y + h : height;
+    if (left >= right || top >= bottom) return HMS_STATUSLED_OK;                                                    // Nothing of it is on the matrix
+
+    if (filled || w <= 2 || h <= 2) {
+        for (int32_t row = top; row < bottom; row++) fillRow(color, left, row, right - left);
+        return HMS_STATUSLED_OK;
+    }
+
+    if (top == y)                    fillRow(color, left, top, right - left);                                       // Edges that are clipped away are not drawn
+    if (bottom == (int32_t)y + h)    fillRow(color, left, bottom - 1, right - left);
+    for (int32_t row = top + (top == y); row < bottom - (bottom == (int32_t)y + h); row++) {
+        if (left == x)               fillRow(color, left, row, 1);
+        if (right == (int32_t)x + w) fillRow(color, right - 1, row, 1);
+    }
+    return HMS_STATUSLED_OK;
+}
+
+HMS_StatusLED_StatusTypeDef HMS_StatusLED_Matrix::blit(const uint8_t *rgb, int16_t x, int16_t y, uint16_t w, uint16_t h, uint16_t stride) {
+    if (!rgb) return HMS_STATUSLED_ERROR;
+    if (stride == 0) stride = w;
+
+    int32_t left   = x < 0 ? 0 : x;
+    int32_t top    = y < 0 ? 0 : y;
+    int32_t right  = ((int32_t)x + w < width)  ? (int32_t)x + w : width;
+    int32_t bottom = ((int32_t)y + h < height) ? (int32_t)y + h : height;
+    if (left >= right || top >= bottom) return HMS_STATUSLED_OK;
+
+    uint8_t reversed[HMS_STATUSLED_MATRIX_CHUNK * 3];
+
+    for (int32_t row = top; row < bottom; row++) {
+        const uint8_t*  source = rgb + ((uint32_t)(row - y) * stride + (left - x)) * 3;
+        const uint16_t* map    = &remap[(uint32_t)row * width + left];
+        uint16_t        count  = right - left;
+
+        while (count) {
+            int8_t   step;
+            uint16_t run = findRun(map, count, step);
+
+            if (map[0] != HMS_STATUSLED_MATRIX_NONE && step > 0) {
+                if (driver.setPixelsRGB(source, run, map[0]) != HMS_STATUSLED_OK) return HMS_STATUSLED_ERROR;
+            } else if (map[0] != HMS_STATUSLED_MATRIX_NONE) {                                                       // Backward run
+                for (uint16_t done = 0; done < run; ) {
+                    uint16_t chunk = (run - done < HMS_STATUSLED_MATRIX_CHUNK) ? run - done : HMS_STATUSLED_MATRIX_CHUNK;
+                    for (uint16_t i = 0; i < chunk; i++) {                                                          // Lowest strip index first
+                        memcpy(reversed + i * 3, source + (done + chunk - 1 - i) * 3, 3);
+                    }
+                    if (driver.setPixelsRGB(reversed, chunk, map[0] - done - (chunk - 1)) != HMS_STATUSLED_OK) return HMS_STATUSLED_ERROR;
+                    done += chunk;
+                }
+            }
+
+            map    += run;
+            source += run * 3;
+            count  -= run;
+        }
+    }
+    return HMS_STATUSLED_OK;
+}
@@ -0,0 +1,184 @@
+#include "HMS_StatusLED_Stream.h"
+#include <string.h>
+
+/*
+    Universes are mapped back to back onto the strip: universe startUniverse + n starts at pixel
+    n * pixelsPerUniverse (170 RGB pixels fill the 510 usable channels of a universe). Channel data is
+    handed to setPixelsRGB() straight from the packet buffer, so the only copy is into the pixel plane.
+
+    A multi-universe frame is shown when
+      - a DDP packet has the push flag set,
+      - an E1.31 sync packet or an Art-Net ArtSync arrives (sync mode),
+      - otherwise once every universe of the strip has arrived. A universe arriving twice before that means
+        a packet was lost, the incomplete frame is shown first so the strip never stalls.
+*/
+
+#define HMS_STATUSLED_E131_VECTOR_ROOT_DATA       0x00000004
+#define HMS_STATUSLED_E131_VECTOR_ROOT_EXTENDED   0x00000008
+#define HMS_STATUSLED_E131_VECTOR_FRAME_DATA      0x00000002
+#define HMS_STATUSLED_E131_VECTOR_FRAME_SYNC      0x00000001
+#define HMS_STATUSLED_E131_OPTION_IGNORE          0xC0                                                              // Preview data, stream terminated
+#define HMS_STATUSLED_E131_DATA_OFFSET            126
+#define HMS_STATUSLED_ARTNET_OP_DMX               0x5000
+#define HMS_STATUSLED_ARTNET_OP_SYNC              0x5200
+#define HMS_STATUSLED_ARTNET_DATA_OFFSET          18
+#define HMS_STATUSLED_DDP_FLAG_VERSION            0x40
+#define HMS_STATUSLED_DDP_FLAG_TIMECODE           0x10
+#define HMS_STATUSLED_DDP_FLAG_REPLY              0x04
+#define HMS_STATUSLED_DDP_FLAG_QUERY              0x02
+#define HMS_STATUSLED_DDP_FLAG_PUSH               0x01
+
+static const uint8_t e131Identifier[12] = {'A', 'S', 'C', '-', 'E', '1', '.', '1', '7', 0, 0, 0};
+static const uint8_t artNetIdentifier[8] = {'A', 'r', 't', '-', 'N', 'e', 't', 0};
+
+static inline uint16_t readBE16(const uint8_t *data) {
+    return (uint16_t)((data[0] << 8) | data[1]);
+}
+
+static inline uint32_t readBE32(const uint8_t *data) {
+    return ((uint32_t)data[0] << 24) | ((uint32_t)data[1] << 16) | ((uint32_t)data[2] << 8) | data[3];
+}
+
+HMS_StatusLED_StreamReceiver::HMS_StatusLED_StreamReceiver(HMS_StatusLED &driver, uint16_t startUniverse, uint16_t pixelsPerUniverse)
+  : driver(driver), startUniverse(startUniverse), pixelsPerUniverse(pixelsPerUniverse), receivedMask(0), sequenceMask(0),
+    syncMode(false), lastProtocol(HMS_STATUSLED_STREAM_UNKNOWN), packetCount(0), droppedPackets(0), frameCount(0) {
+    if (this->pixelsPerUniverse == 0 || this->pixelsPerUniverse > 170) this->pixelsPerUniverse = 170;
+
+    uint32_t universes = (driver.getPixelCount() + this->pixelsPerUniverse - 1) / this->pixelsPerUniverse;
+    universeCount = universes > HMS_STATUSLED_STREAM_MAX_UNIVERSES ? HMS_STATUSLED_STREAM_MAX_UNIVERSES : universes;
+    memset(lastSequence, 0, sizeof(lastSequence));
+}
+
+HMS_StatusLED_StatusTypeDef HMS_StatusLED_StreamReceiver::handlePacket(const uint8_t *packet, uint32_t length) {
+    if (!packet) return drop();
+
+    if (length >= HMS_STATUSLED_ARTNET_DATA_OFFSET && memcmp(packet, artNetIdentifier, sizeof(artNetIdentifier)) == 0) {
+        lastProtocol = HMS_STATUSLED_STREAM_ARTNET;
+        return handleArtNet(packet, length);
+    }
+    if (length >= 38 && memcmp(packet + 4, e131Identifier, sizeof(e131Identifier)) == 0) {
+        lastProtocol = HMS_STATUSLED_STREAM_E131;
+        return handleE131(packet, length);
+    }
+    if (length >= 10 && (packet[0] & 0xC0) == HMS_STATUSLED_DDP_FLAG_VERSION) {
+        lastProtocol = HMS_STATUSLED_STREAM_DDP;
+        return handleDDP(packet, length);
+    }
+
+    lastProtocol = HMS_STATUSLED_STREAM_UNKNOWN;
+    return drop();
+}
+
+HMS_StatusLED_StatusTypeDef HMS_StatusLED_StreamReceiver::handleDDP(const uint8_t *packet, uint32_t length) {
+    uint8_t  flags        = packet[0];
+    uint32_t headerLength = (flags & HMS_STATUSLED_DDP_FLAG_TIMECODE) ? 14 : 10;
+    if (length < headerLength || (flags & (HMS_STATUSLED_DDP_FLAG_QUERY | HMS_STATUSLED_DDP_FLAG_REPLY)) ||
+        packet[3] > 1) {                                                                                            // Destination 1 is the default output device
+        return drop();
+    }
+
+    uint32_t offset     = readBE32(packet + 4);                                                                     // Byte offset into the strip
+    uint32_t dataLength = readBE16(packet + 8);
+    if (dataLength > length - headerLength || offset % 3) {
+        return drop();
+    }
+
+    uint32_t pixel = offset / 3;
+    uint32_t count = dataLength / 3;
+    if (pixel < driver.getPixelCount() && count) {
+        if (count > driver.getPixelCount() - pixel) count = driver.getPixelCount() - pixel;
+        driver.setPixelsRGB(packet + headerLength, count, pixel);
+    }
+    packetCount++;
+
+    return (flags & HMS_STATUSLED_DDP_FLAG_PUSH) ? completeFrame() : HMS_STATUSLED_OK;
+}
+
+HMS_StatusLED_StatusTypeDef HMS_StatusLED_StreamReceiver::handleE131(const uint8_t *packet, uint32_t length) {
+    uint32_t rootVector = readBE32(packet + 18);
+    if (rootVector == HMS_STATUSLED_E131_VECTOR_ROOT_EXTENDED) {
+        if (length < 47 || readBE32(packet + 40) != HMS_STATUSLED_E131_VECTOR_FRAME_SYNC) {
+            return drop();                                                                                          // Universe discovery is not pixel data
+        }
+        syncMode = true;
+        packetCount++;
+        return completeFrame();
+    }
+
+    if (rootVector != HMS_STATUSLED_E131_VECTOR_ROOT_DATA || length < HMS_STATUSLED_E131_DATA_OFFSET ||
+        readBE32(packet + 40) != HMS_STATUSLED_E131_VECTOR_FRAME_DATA || (packet[112] & HMS_STATUSLED_E131_OPTION_IGNORE) ||
+        packet[117] != 0x02 || packet[118] != 0xA1) {
+        return drop();
+    }
+
+    uint16_t valueCount = readBE16(packet + 123);                                                                   // Start code + channels
+    if (valueCount == 0 || 125U + valueCount > length || packet[125] != 0) {
+        return drop();                                                                                              // Only DMX512 start code 0 carries levels
+    }
+
+    syncMode = readBE16(packet + 109) != 0;                                                                         // Non-zero sync address: wait for the sync packet
+    return handleUniverse(readBE16(packet + 113), packet[111], false, packet + HMS_STATUSLED_E131_DATA_OFFSET, valueCount - 1);
+}
+
+HMS_StatusLED_StatusTypeDef HMS_StatusLED_StreamReceiver::handleArtNet(const uint8_t *packet, uint32_t length) {
+    uint16_t opCode = packet[8] | (packet[9] << 8);                                                                 // The only little endian field
+    if (opCode == HMS_STATUSLED_ARTNET_OP_SYNC) {
+        syncMode = true;                                                                                            // Art-Net nodes stay in sync mode once an ArtSync was seen
+        packetCount++;
+        return completeFrame();
+    }
+
+    uint16_t dataLength = readBE16(packet + 16);
+    if (opCode != HMS_STATUSLED_ARTNET_OP_DMX || dataLength > length - HMS_STATUSLED_ARTNET_DATA_OFFSET) {
+        return drop();
+    }
+
+    uint16_t portAddress = packet[14] | ((packet[15] & 0x7F) << 8);                                                 // Net:SubUni, universes count from 0
+    return handleUniverse(portAddress, packet[12], true, packet + HMS_STATUSLED_ARTNET_DATA_OFFSET, dataLength);
+}
+
+HMS_StatusLED_StatusTypeDef HMS_StatusLED_StreamReceiver::handleUniverse(uint16_t universe, uint8_t sequence, bool zeroDisablesSequence, const uint8_t *data, uint16_t length) {
+    if (universe < startUniverse || universe - startUniverse >= universeCount) {
+        return drop();
+    }
+
+    uint8_t  slot = universe - startUniverse;
+    uint32_t bit  = 1UL << slot;
+    if (!(zeroDisablesSequence && sequence == 0) && (sequenceMask & bit)) {                                         // Art-Net sends 0 with sequencing off, in E1.31 it is an ordinary value
+        int8_t age = (int8_t)(sequence - lastSequence[slot]);
+        if (age <= 0 && age > -20) {
+            return drop();                                                                                          // Duplicate or reordered packet (E1.31 6.7.2)
+        }
+    }
+    lastSequence[slot] = sequence;
+    sequenceMask      |= bit;
+
+    if ((receivedMask & bit) && !syncMode) {
+        completeFrame();                                                                                            // Next frame started, one of the last frame's universes was lost
+    }
+
+    uint32_t pixel = (uint32_t)slot * pixelsPerUniverse;
+    uint32_t count = length / 3;
+    if (count > pixelsPerUniverse) count = pixelsPerUniverse;
+    if (count > driver.getPixelCount() - pixel) count = driver.getPixelCount() - pixel;
+    if (count) driver.setPixelsRGB(data, count, pixel);
+
+    receivedMask |= bit;
+    packetCount++;
+
+    if (!syncMode && receivedMask == ((universeCount == 32) ? 0xFFFFFFFFUL : (1UL << universeCount) - 1)) {
+        return completeFrame();
+    }
+    return HMS_STATUSLED_OK;
+}
+
+HMS_StatusLED_StatusTypeDef HMS_StatusLED_StreamReceiver::completeFrame() {
+    receivedMask = 0;
+    frameCount++;
+    return driver.show();
+}
+
+HMS_StatusLED_StatusTypeDef HMS_StatusLED_StreamReceiver::drop() {
+    droppedPackets++;
+    return HMS_STATUSLED_ERROR;
+}
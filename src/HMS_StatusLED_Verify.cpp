@@ -0,0 +1,161 @@
+#include "HMS_StatusLED_Verify.h"
+
+/*
+    Every front end reduces its backend's encoded stream to runs of the line being active or idle, so one
+    decoder checks them all. A bit is an active run followed by an idle run; an idle run that reaches the
+    latch time of the profile ends the frame, anything after it is ignored. Compare and SPI streams end
+    with the idle slots of the buffer only, add the latch gap of waitForTransfer() with addIdle().
+*/
+
+HMS_StatusLED_WireDecoder::HMS_StatusLED_WireDecoder(const HMS_StatusLED_Timing &timing, uint16_t toleranceNs, uint16_t periodToleranceNs)
+  : timing(timing), toleranceNs(toleranceNs), periodToleranceNs(periodToleranceNs) {
+}
+
+void HMS_StatusLED_WireDecoder::reset() {
+    runs.clear();
+}
+
+void HMS_StatusLED_WireDecoder::addLevel(bool active, uint64_t ps) {
+    if (ps == 0) return;
+
+    if (!runs.empty() && runs.back().active == active) {                                                            // Runs always alternate
+        runs.back().ps += ps;
+    } else {
+        runs.push_back({ps, active});
+    }
+}
+
+void HMS_StatusLED_WireDecoder::addCompareStream(const uint8_t *compare, uint32_t length, uint32_t periodTicks, uint16_t timerMHz) {
+    if (!compare || timerMHz == 0) return;
+
+    for (uint32_t slot = 0; slot < length; slot++) {
+        uint32_t highTicks = compare[slot] < periodTicks ? compare[slot] : periodTicks;                             // PWM mode 1: active while the counter is below the compare value
+        addLevel(true,  ((uint64_t)highTicks * 1000000 + timerMHz / 2) / timerMHz);
+        addLevel(false, ((uint64_t)(periodTicks - highTicks) * 1000000 + timerMHz / 2) / timerMHz);
+    }
+}
+
+void HMS_StatusLED_WireDecoder::addRMTItems(const uint32_t *items, uint32_t count, uint16_t tickNs) {
+    if (!items) return;
+
+    for (uint32_t item = 0; item < count; item++) {
+        uint32_t duration0 = items[item] & 0x7FFF;                                                                  // rmt_item32_t: duration0:15, level0:1, duration1:15, level1:1
+        uint32_t duration1 = (items[item] >> 16) & 0x7FFF;
+        bool     level0    = (items[item] >> 15) & 1;
+        bool     level1    = (items[item] >> 31) & 1;
+
+        if (duration0 == 0) return;                                                                                 // The RMT stops at a zero duration
+        addLevel(level0 != timing.inverted, (uint64_t)duration0 * tickNs * 1000);
+        if (duration1 == 0) return;
+        addLevel(level1 != timing.inverted, (uint64_t)duration1 * tickNs * 1000);
+    }
+}
+
+void HMS_StatusLED_WireDecoder::addSPIStream(const uint8_t *bytes, uint32_t length, uint32_t spiHz) {
+    if (!bytes || spiHz == 0) return;
+
+    uint64_t bitPs = 1000000000000ULL / spiHz;
+    for (uint32_t i = 0; i < length; i++) {
+        for (int8_t bit = 7; bit >= 0; bit--) {
+            addLevel(((bytes[i] >> bit) & 1) != timing.inverted, bitPs);
+        }
+    }
+}
+
+void HMS_StatusLED_WireDecoder::addWireBytes(const uint8_t *bytes, uint32_t length) {
+    if (!bytes) return;
+
+    for (uint32_t i = 0; i < length; i++) {
+        for (int8_t bit = 7; bit >= 0; bit--) {
+            uint16_t highNs = ((bytes[i] >> bit) & 1) ? timing.t1hNs : timing.t0hNs;
+            addLevel(true,  (uint64_t)highNs * 1000);
+            addLevel(false, (uint64_t)(timing.bitNs - highNs) * 1000);
+        }
+    }
+}
+
+void HMS_StatusLED_WireDecoder::addIdle(uint32_t ns) {
+    addLevel(false, (uint64_t)ns * 1000);
+}
+
+HMS_StatusLED_WireReport HMS_StatusLED_WireDecoder::decode(uint8_t *bytes, uint32_t maxBytes) const {
+    HMS_StatusLED_WireReport report = {};
+    report.firstInvalidBit = UINT32_MAX;
+    report.t0hMinNs        = UINT32_MAX;
+    report.t1hMinNs        = UINT32_MAX;
+    report.periodMinNs     = UINT32_MAX;
+    report.marginNs        = INT32_MAX;
+
+    const uint64_t latchPs = (uint64_t)timing.resetUs * 1000000;
+    const uint64_t bitPs   = (uint64_t)timing.bitNs * 1000;
+    uint64_t       dataPs  = 0;
+    uint8_t        current = 0;
+
+    size_t i = 0;
+    while (i < runs.size() && !runs[i].active) i++;                                                                 // Idle line before the first bit
+
+    for (; i < runs.size(); i += 2) {
+        uint64_t highPs = runs[i].ps;
+        uint64_t lowPs  = (i + 1 < runs.size()) ? runs[i + 1].ps : 0;
+        bool     last   = (i + 2 >= runs.size()) || lowPs >= latchPs;
+
+        int32_t highNs = (int32_t)((highPs + 500) / 1000);
+        int32_t delta0 = highNs > timing.t0hNs ? highNs - timing.t0hNs : timing.t0hNs - highNs;
+        int32_t delta1 = highNs > timing.t1hNs ? highNs - timing.t1hNs : timing.t1hNs - highNs;
+        bool    one    = delta1 < delta0;                                                                           // Nearest pulse width wins, the margin tells how close it was
+        int32_t margin = (int32_t)toleranceNs - (one ? delta1 : delta0);
+
+        if (one) {
+            if ((uint32_t)highNs < report.t1hMinNs) report.t1hMinNs = highNs;
+            if ((uint32_t)highNs > report.t1hMaxNs) report.t1hMaxNs = highNs;
+        } else {
+            if ((uint32_t)highNs < report.t0hMinNs) report.t0hMinNs = highNs;
+            if ((uint32_t)highNs > report.t0hMaxNs) report.t0hMaxNs = highNs;
+        }
+
+        if (!last) {
+            int32_t periodNs = (int32_t)((highPs + lowPs + 500) / 1000);
+            int32_t delta    = periodNs > timing.bitNs ? periodNs - timing.bitNs : timing.bitNs - periodNs;
+            if ((int32_t)periodToleranceNs - delta < margin) margin = (int32_t)periodToleranceNs - delta;
+            if ((uint32_t)periodNs < report.periodMinNs) report.periodMinNs = periodNs;
+            if ((uint32_t)periodNs > report.periodMaxNs) report.periodMaxNs = periodNs;
+            dataPs += highPs + lowPs;
+        } else {
+            dataPs += highPs > bitPs ? highPs : bitPs;                                                              // The latch starts once the last bit period is over
+            report.resetNs = (uint32_t)(lowPs / 1000);
+        }
+
+        if (margin < report.marginNs) report.marginNs = margin;
+        if (margin < 0) {
+            if (report.invalidBits++ == 0) report.firstInvalidBit = report.bits;
+        }
+
+        current = (current << 1) | (one ? 1 : 0);
+        if ((++report.bits & 7) == 0) {
+            if (bytes && report.bytes < maxBytes) bytes[report.bytes] = current;
+            report.bytes++;
+        }
+
+        if (last) break;
+    }
+
+    if (report.t0hMinNs == UINT32_MAX)    report.t0hMinNs    = 0;
+    if (report.t1hMinNs == UINT32_MAX)    report.t1hMinNs    = 0;
+    if (report.periodMinNs == UINT32_MAX) report.periodMinNs = 0;
+    if (report.marginNs == INT32_MAX)     report.marginNs    = 0;
+
+    uint32_t spread[3] = {
+        report.t0hMaxNs - report.t0hMinNs,
+        report.t1hMaxNs - report.t1hMinNs,
+        report.periodMaxNs - report.periodMinNs
+    };
+    for (uint8_t s = 0; s < 3; s++) {
+        if (spread[s] > report.jitterNs) report.jitterNs = spread[s];
+    }
+
+    report.resetOk = report.resetNs >= (uint32_t)timing.resetUs * 1000;
+    report.frameNs = (uint32_t)(dataPs / 1000) + (uint32_t)timing.resetUs * 1000;
+    report.maxFps  = report.frameNs ? 1000000000UL / report.frameNs : 0;
+
+    return report;
+}